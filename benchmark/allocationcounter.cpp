@@ -0,0 +1,50 @@
+#include "allocationcounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<std::size_t> allocations{0};
+
+std::size_t allocationCount()
+{
+    return allocations.load( std::memory_order_relaxed );
+}
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add( 1, std::memory_order_relaxed );
+    if ( void* p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Used by std::pmr::new_delete_resource()
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations.fetch_add( 1, std::memory_order_relaxed );
+    const auto align{ static_cast<std::size_t>( alignment ) };
+    if ( void* p = std::aligned_alloc( align, ( ( size ? size : 1 ) + align - 1 ) / align * align ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
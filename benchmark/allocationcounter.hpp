@@ -0,0 +1,21 @@
+#ifndef CLP_BENCHMARK_ALLOCATIONCOUNTER_HPP
+#define CLP_BENCHMARK_ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+// Number of calls to the global operator new (also the aligned one) since
+// program start.
+// Only available to executables, that link allocationcounter.cpp.
+std::size_t allocationCount();
+
+// Returns the average number of allocations of a single call.
+template <class FUNCTION>
+double countAllocations(std::size_t iterations, FUNCTION function)
+{
+    const std::size_t before{ allocationCount() };
+    for( std::size_t i{0}; i < iterations; ++i )
+        function();
+    return static_cast<double>( allocationCount() - before ) / iterations;
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace elrat::clp;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Resumes the coroutines after a delay, like an I/O completion. As all
+    // of them wait for the same time, the earliest is always at the front.
+    class Timer
+    {
+    public:
+        Timer()
+        : thread{ [this]{ run(); } }
+        {
+        }
+
+        ~Timer()
+        {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            changed.notify_one();
+            thread.join();
+        }
+
+        void resumeAfter(Clock::duration delay, Resumer resume)
+        {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                waiting.emplace_back( Clock::now() + delay, resume );
+            }
+            changed.notify_one();
+        }
+    private:
+        std::mutex                                      mutex;
+        std::condition_variable                         changed;
+        std::deque<std::pair<Clock::time_point, Resumer>> waiting;
+        bool                                            stopping{ false };
+        std::thread                                     thread;
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( !stopping || !waiting.empty() )
+            {
+                if ( waiting.empty() )
+                    changed.wait( lock );
+                else if ( waiting.front().first <= Clock::now() )
+                {
+                    auto resume{ waiting.front().second };
+                    waiting.pop_front();
+                    resume();
+                }
+                else
+                    changed.wait_until( lock, waiting.front().first );
+            }
+        }
+    };
+}
+
+// Lines, whose commands wait for 1 ms: blocking the executor's thread, and
+// suspended until a timer resumes them. Both on an executor with 4 threads.
+int main()
+{
+    const int count{ 5000 };
+    const auto delay{ std::chrono::milliseconds(1) };
+    Processor processor;
+    processor.setExecutor( Executor::Create(4) );
+    Timer timer;
+    processor.attach( CommandDescriptor::Create("block"), 
+        [delay](const CommandLineView&) { std::this_thread::sleep_for( delay ); });
+    processor.attachAsync( CommandDescriptor::Create("suspend"), 
+        [&timer, delay](CommandLine) -> AsyncTask {
+            co_await suspend( [&timer, delay](Resumer resume) { 
+                timer.resumeAfter( delay, resume ); 
+            });
+        });
+
+    for( std::string command : { "block", "suspend" } )
+    {
+        const auto start{ Clock::now() };
+        for( int i{0}; i < count; i++ )
+            processor.submit( command, [](const Diagnostic&, std::exception_ptr) {} );
+        processor.drain();
+        const std::chrono::duration<double> elapsed{ Clock::now() - start };
+        report( "Processor::submit, 1 ms " + command + ", 4 threads", 
+            count / elapsed.count(), "lines/s" );
+    }
+    return 0;
+}
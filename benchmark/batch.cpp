@@ -0,0 +1,44 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace elrat::clp;
+
+int main()
+{
+    Processor processor;
+    for( int i{0}; i < 100; i++ )
+        processor.attach( 
+            CommandDescriptor::Create( "command-" + std::to_string(i), "", {
+                ParameterDescriptor::Create("n", "", Mandatory, ParameterType::WholeNumber) }),
+            [](const CommandLineView& cmdline) { keep(cmdline); } );
+
+    // Runs of ten lines for the same command, every seventh line is invalid.
+    std::vector<std::string> input;
+    for( int i{0}; i < 10000; i++ )
+        input.push_back( "command-" + std::to_string( (i / 10) % 100 ) 
+            + ( i % 7 ? " 42" : " x" ) );
+    const std::vector<std::string_view> lines( input.begin(), input.end() );
+
+    const std::size_t iterations{ 20 };
+    report( "Processor::process", measure( iterations, [&]{
+        for( auto& line : input )
+        {
+            try 
+            {
+                processor.process(line);
+            }
+            catch( const InputException& ) 
+            {
+            }
+        }
+    }) / lines.size(), "ns/line" );
+    report( "Processor::processBatch", measure( iterations, [&]{
+        keep( processor.processBatch(lines) );
+    }) / lines.size(), "ns/line" );
+    return 0;
+}
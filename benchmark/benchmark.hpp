@@ -0,0 +1,36 @@
+#ifndef CLP_BENCHMARK_HPP
+#define CLP_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Prevents the compiler from optimizing away a result, that is not used otherwise.
+template <class T>
+void keep(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Returns the average duration of a single call in nanoseconds.
+template <class FUNCTION>
+double measure(std::size_t iterations, FUNCTION function)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start{ Clock::now() };
+    for( std::size_t i{0}; i < iterations; ++i )
+        function();
+    const std::chrono::duration<double, std::nano> elapsed{ Clock::now() - start };
+    return elapsed.count() / iterations;
+}
+
+inline void report(const std::string& label, double value, const std::string& unit = "ns")
+{
+    std::cout << std::left << std::setw(48) << label 
+        << std::right << std::setw(12) << std::fixed << std::setprecision(1) << value 
+        << ' ' << unit << '\n';
+}
+
+#endif
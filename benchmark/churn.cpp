@@ -0,0 +1,78 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace elrat::clp;
+
+// Read throughput of a shared Processor, while another thread keeps 
+// attaching and detaching commands (or not). The number of reading 
+// threads is the first argument (default: number of cores).
+int main(int argc, char** argv)
+{
+    Processor processor;
+    for( int i{0}; i < 100; i++ )
+        processor.attach(
+            CommandDescriptor::Create( "command-" + std::to_string(i), "", {
+                TypedParameterDescriptor<int>::Create("n") }),
+            [](const CommandLineView& cmdline) { keep(cmdline); } );
+    for( int i{0}; i < 10; i++ )
+        processor.attach( CommandDescriptor::Create( "churn-" + std::to_string(i) ) );
+
+    std::vector<std::string> lines;
+    for( int i{0}; i < 1000; i++ )
+        lines.push_back( "command-" + std::to_string( i % 100 ) + " " + std::to_string(i) );
+
+    const unsigned cores{ std::max( 1u, std::thread::hardware_concurrency() ) };
+    const unsigned readers{ argc > 1 ? static_cast<unsigned>( std::atoi(argv[1]) ) : cores };
+    const auto duration{ std::chrono::milliseconds(500) };
+
+    for( bool churn : { false, true } )
+    {
+        std::atomic<bool> done{false};
+        std::atomic<long> processed{0};
+        std::atomic<long> changes{0};
+        std::vector<std::thread> threads;
+        for( unsigned t{0}; t < readers; t++ )
+            threads.emplace_back( [&]{
+                long count{0};
+                while( !done )
+                    for( auto& line : lines )
+                    {
+                        keep( processor.tryProcess(line).getCode() );
+                        count++;
+                    }
+                processed += count;
+            });
+        if ( churn )
+            threads.emplace_back( [&]{
+                for( long i{0}; !done; i++ )
+                {
+                    const std::string name{ "churn-" + std::to_string(i % 10) };
+                    if ( i % 20 < 10 )
+                        processor.attach( name, [](const CommandLineView&) {} );
+                    else
+                        processor.detach( name );
+                    changes++;
+                }
+            });
+        std::this_thread::sleep_for( duration );
+        done = true;
+        for( auto& thread : threads )
+            thread.join();
+
+        const double seconds{ std::chrono::duration<double>(duration).count() };
+        const std::string label{ churn ? "with churn" : "without churn" };
+        report( "Processor::tryProcess, " + label, processed / seconds / 1e6, "Mlines/s" );
+        if ( churn )
+            report( "  attach/detach", changes / seconds / 1e3, "k/s" );
+    }
+    return 0;
+}
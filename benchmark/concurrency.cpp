@@ -0,0 +1,56 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace elrat::clp;
+
+// Throughput of one Processor shared by 1, 2, 4, ... threads. The maximum
+// number of threads is the first argument (default: number of cores).
+int main(int argc, char** argv)
+{
+    Processor processor;
+    for( int i{0}; i < 100; i++ )
+        processor.attach(
+            CommandDescriptor::Create( "command-" + std::to_string(i), "", {
+                TypedParameterDescriptor<int>::Create("n", "", Mandatory, { AtLeast(0) }) },{
+                OptionDescriptor::Create("verbose") }),
+            [](const CommandLineView& cmdline) { keep(cmdline); } );
+
+    std::vector<std::string> lines;
+    for( int i{0}; i < 1000; i++ )
+        lines.push_back( "command-" + std::to_string( i % 100 ) + " "
+            + std::to_string(i) + ( i % 3 ? "" : " --verbose" ) );
+
+    const unsigned cores{ std::max( 1u, std::thread::hardware_concurrency() ) };
+    const unsigned max_threads{ argc > 1 ? static_cast<unsigned>( std::atoi(argv[1]) ) : cores };
+    const int rounds{ 200 };
+    for( unsigned threads{1}; threads <= max_threads; threads *= 2 )
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto start{ Clock::now() };
+        std::vector<std::thread> workers;
+        for( unsigned t{0}; t < threads; t++ )
+            workers.emplace_back( [&]{
+                for( int round{0}; round < rounds; round++ )
+                    for( auto& line : lines )
+                        keep( processor.tryProcess(line).getCode() );
+            });
+        for( auto& worker : workers )
+            worker.join();
+        const std::chrono::duration<double> elapsed{ Clock::now() - start };
+        report(
+            "Processor::tryProcess, " + std::to_string(threads) + " thread(s)",
+            threads * rounds * lines.size() / elapsed.count() / 1e6,
+            "Mlines/s" );
+        if ( threads < max_threads && threads * 2 > max_threads )
+            threads = max_threads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/convert.hpp"
+#include "elrat/clp/descriptors.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace elrat::clp;
+
+// The conversion, that convert<T> used for all types before.
+template <class T>
+static T convertStream(std::string_view arg)
+{
+    std::stringstream ss;
+    ss << arg;
+    T result;
+    ss >> result;
+    return result;
+}
+
+template <class T>
+static void compare(const char* type, const std::vector<std::string>& arguments)
+{
+    const std::size_t iterations{ 200000 };
+    for( auto& argument : arguments )
+    {
+        std::cout << type << " [" << argument << "]\n";
+        report( "  std::stringstream", measure( iterations, [&]{
+            keep( convertStream<T>(argument) );
+        }));
+        report( "  std::from_chars", measure( iterations, [&]{
+            keep( convert<T>(argument) );
+        }));
+    }
+}
+
+int main()
+{
+    compare<int>( "int", { "7", "-123456789" } );
+    compare<unsigned long long>( "unsigned long long", { "18446744073709551615" } );
+    compare<double>( "double", { "1.5", "-1234567890.0987654321" } );
+
+    const std::size_t iterations{ 200000 };
+    auto constraint{ InRange(10,19) };
+    std::cout << "InRange(10,19) [15]\n";
+    report( "  Constraint::validate", measure( iterations, [&]{
+        keep( constraint->validate("15") );
+    }));
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/descriptors.hpp"
+
+#include <algorithm>
+#include <string>
+
+using namespace elrat::clp;
+
+// How DescriptorMap::validate resolved the command before: every descriptor
+// gets asked, until one of them accepts the command line.
+static bool validateLinear(const DescriptorMap& map, const CommandLineView& cmdline)
+{
+    for( auto& descriptor : map.getCommandDescriptors() )
+        if ( descriptor->validate(cmdline) )
+            return true;
+    return false;
+}
+
+int main()
+{
+    for( std::size_t count : { 10, 100, 1000, 10000, 100000 } )
+    {
+        DescriptorMap map;
+        for( std::size_t i{0}; i < count; i++ )
+            map.attach( CommandDescriptor::Create( "command-" + std::to_string(i) ) );
+
+        // The last command is the worst case for the linear search.
+        const std::string name{ "command-" + std::to_string(count - 1) };
+        CommandLineView cmdline;
+        cmdline.setCommand( name );
+
+        const std::size_t iterations{ std::max<std::size_t>( 100, 10000000 / count ) };
+        std::cout << count << " descriptors\n";
+        report( "  linear search", measure( iterations, [&]{ 
+            keep( validateLinear(map, cmdline) ); 
+        }));
+        report( "  name index", measure( 1000000, [&]{ 
+            keep( map.validate(cmdline) ); 
+        }));
+    }
+    return 0;
+}
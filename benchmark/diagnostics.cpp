@@ -0,0 +1,47 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace elrat::clp;
+
+int main()
+{
+    Processor processor;
+    processor.attach( 
+        CommandDescriptor::Create( "command", "", {
+            ParameterDescriptor::Create("n", "", Mandatory, ParameterType::WholeNumber) }),
+        [](const CommandLineView& cmdline) { keep(cmdline); } );
+
+    // Rejected by the parser, the lookup and the descriptor
+    const std::vector<std::string> input {
+        "command 42 = 1", "command -aa", "unknown 42", "command", "command 1 2", 
+        "command x", "command 42 --option"
+    };
+
+    const std::size_t iterations{ 100000 };
+    report( "Processor::process (exception)", measure( iterations, [&]{
+        for( auto& line : input )
+        {
+            try 
+            {
+                processor.process(line);
+            }
+            catch( const InputException& e ) 
+            {
+                keep(e);
+            }
+        }
+    }) / input.size(), "ns/line" );
+    report( "Processor::tryProcess", measure( iterations, [&]{
+        for( auto& line : input )
+            keep( processor.tryProcess(line).getCode() );
+    }) / input.size(), "ns/line" );
+    report( "Processor::tryProcess + getMessage", measure( iterations, [&]{
+        for( auto& line : input )
+            keep( processor.tryProcess(line).getMessage() );
+    }) / input.size(), "ns/line" );
+    return 0;
+}
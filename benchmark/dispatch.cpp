@@ -0,0 +1,67 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/commandmap.hpp"
+#include "elrat/clp/processor.hpp"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace elrat::clp;
+
+struct Nothing : public Command
+{
+    void execute(const CommandLine&) {}
+    void execute(const CommandLineView&) {}
+};
+
+// The CommandMap before: a tree of handler lists, iterated by value.
+struct TreeMap
+{
+    std::map<std::string, std::vector<CommandPtr>, std::less<>> commands;
+
+    void invoke(const CommandLineView& cmdline) const
+    {
+        auto it{ commands.find( cmdline.getCommand() ) };
+        if ( it == commands.end() )
+            throw CommandNotFoundException( std::string(cmdline.getCommand()) );
+        for( auto cmd : it->second )
+            cmd->execute(cmdline);
+    }
+};
+
+int main()
+{
+    const std::size_t iterations{ 1000000 };
+    auto command{ Command::Create<Nothing>() };
+    for( std::size_t count : { 10, 1000, 100000 } )
+    {
+        TreeMap tree;
+        CommandMap commands;
+        Processor processor;
+        for( std::size_t i{0}; i < count; i++ )
+        {
+            const std::string name{ "command-" + std::to_string(i) };
+            tree.commands[name].push_back( command );
+            commands.attach( name, command );
+            processor.attach( CommandDescriptor::Create(name), command );
+        }
+
+        const std::string input{ "command-" + std::to_string(count / 2) };
+        CommandLineView cmdline;
+        cmdline.setCommand( input );
+
+        std::cout << count << " names\n";
+        report( "  invoke, std::map", measure( iterations, [&]{ 
+            tree.invoke(cmdline); 
+        }));
+        report( "  invoke, CommandMap", measure( iterations, [&]{ 
+            commands.invoke(cmdline); 
+        }));
+        report( "  Processor::process", measure( iterations, [&]{ 
+            processor.process(input); 
+        }));
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "allocationcounter.hpp"
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <memory_resource>
+#include <string>
+
+using namespace elrat::clp;
+
+namespace
+{
+    // Too long for the inline capacity of a CommandLine
+    const std::string Line{
+        "copy --recursive --bandwidth = 1000 --exclude = *.tmp "
+        "/home/user/projects/source/directory /mnt/backup/target/directory" };
+
+    // Hands out CommandLines only, like parsers that don't provide views
+    class CopyingParser : public Parser
+    {
+    public:
+        CommandLine parse(const std::string& input) const override { return native.parse(input); }
+        void parse(const std::string& input, CommandLine& result) const override { native.parse(input, result); }
+        const std::string& getSyntaxDescription() const override { return native.getSyntaxDescription(); }
+    private:
+        NativeParser native;
+    };
+
+    // The command takes what the parser provides, so it isn't copied
+    void configure(Processor& processor, bool views)
+    {
+        auto descriptor{
+            CommandDescriptor::Create( "copy", "", {
+                ParameterDescriptor::Create("source"),
+                ParameterDescriptor::Create("target") },{
+                OptionDescriptor::Create("recursive"),
+                OptionDescriptor::Create("bandwidth", "", {
+                    TypedParameterDescriptor<int>::Create("kbps") }),
+                OptionDescriptor::Create("exclude", "", {
+                    ParameterDescriptor::Create("pattern") }) }) };
+        if ( views )
+            processor.attach( descriptor, [](const CommandLineView& cmdline) { keep(cmdline); } );
+        else
+            processor.attach( descriptor, [](const CommandLine& cmdline) { keep(cmdline); } );
+    }
+
+    // A request, whose memory comes from an arena on the stack
+    template <class FUNCTION>
+    void inArena(FUNCTION function)
+    {
+        char buffer[2048];
+        std::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer) );
+        function( arena );
+    }
+}
+
+// A command line per request, from the global allocator or a monotonic
+// arena, which is released as a whole at the end of the request.
+int main()
+{
+    const std::size_t iterations{ 200000 };
+    NativeParser parser;
+    auto parse_default{ [&]{
+        CommandLine cmdline;
+        parser.parse( Line, cmdline );
+        keep( cmdline ); } };
+    auto parse_arena{ [&]{ inArena( [&](std::pmr::memory_resource& arena) {
+        CommandLine cmdline( &arena );
+        parser.parse( Line, cmdline );
+        keep( cmdline ); } ); } };
+    report( "allocations, CommandLine, default", countAllocations( iterations, parse_default ), "/parse" );
+    report( "allocations, CommandLine, arena", countAllocations( iterations, parse_arena ), "/parse" );
+    report( "duration, CommandLine, default", measure( iterations, parse_default ) );
+    report( "duration, CommandLine, arena", measure( iterations, parse_arena ) );
+
+    for( bool views : { true, false } )
+    {
+        std::cout << ( views ? "[NativeParser]\n" : "[Parser without views]\n" );
+        Processor processor( views ? std::shared_ptr<Parser>( std::make_shared<NativeParser>() )
+                                   : std::make_shared<CopyingParser>() );
+        configure( processor, views );
+        auto process_default{ [&]{ keep( processor.tryProcess( Line ) ); } };
+        auto process_arena{ [&]{ inArena( [&](std::pmr::memory_resource& arena) {
+            keep( processor.tryProcess( Line, &arena ) ); } ); } };
+        if ( !processor.tryProcess( Line ).ok() )
+            return 1;
+        report( "  allocations, tryProcess, thread's buffers", countAllocations( iterations, process_default ), "/line" );
+        report( "  allocations, tryProcess, arena", countAllocations( iterations, process_arena ), "/line" );
+        report( "  duration, tryProcess, thread's buffers", measure( iterations, process_default ) );
+        report( "  duration, tryProcess, arena", measure( iterations, process_arena ) );
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/descriptors.hpp"
+
+#include <algorithm>
+#include <string>
+
+using namespace elrat::clp;
+
+// How CommandDescriptor::validate matched options before: each option
+// descriptor compares its name with the option.
+static bool matchLinear(const CommandDescriptor& command, const CommandLineView& cmdline)
+{
+    for( int i{0}; i < cmdline.getOptionCount(); ++i )
+    {
+        bool match{false};
+        for( auto& option : command.getOptions() )
+            if ( (match = option->validate( cmdline.getOption(i), cmdline.getOptionParameters(i) )) )
+                break;
+        if ( !match )
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    const std::size_t iterations{ 200000 };
+    for( int count : { 4, 16, 64 } )
+    {
+        OptionDescriptors options;
+        for( int i{0}; i < count; i++ )
+            options.push_back( OptionDescriptor::Create( "long-option-name-" + std::to_string(i) ) );
+        auto command{ CommandDescriptor::Create( "command", "", {}, options ) };
+
+        // Eight options from the end of the declaration list
+        CommandLineView cmdline;
+        cmdline.setCommand("command");
+        for( int i{ std::max(0, count - 8) }; i < count; i++ )
+            cmdline.addOption( options[i]->getName() );
+
+        std::cout << count << " declared options, " << cmdline.getOptionCount() << " given\n";
+        report( "  linear search", measure( iterations, [&]{ 
+            keep( matchLinear(*command, cmdline) ); 
+        }));
+        report( "  CommandDescriptor::validate", measure( iterations, [&]{ 
+            keep( command->validate(cmdline) ); 
+        }));
+    }
+    return 0;
+}
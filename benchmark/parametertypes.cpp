@@ -0,0 +1,49 @@
+#include "benchmark.hpp"
+
+#include "common/lexical.hpp"
+#include "common/regex.hpp"
+
+#include <string>
+#include <vector>
+
+// Compares the regular expressions, that were used to check parameter types,
+// with their hand-written replacements.
+template <class REFERENCE, class PREDICATE>
+static void compare(
+    const char* name,
+    const REFERENCE& reference,
+    PREDICATE predicate,
+    const std::vector<std::string>& arguments )
+{
+    const std::size_t iterations{ 100000 };
+    std::cout << name << "\n";
+    for( auto& argument : arguments )
+    {
+        std::cout << "  [" << argument << "]\n";
+        report( "    std::regex", measure( iterations, [&]{ 
+            keep( reference(argument) ); 
+        }));
+        report( "    hand-written", measure( iterations, [&]{ 
+            keep( predicate(argument) ); 
+        }));
+    }
+}
+
+int main()
+{
+    compare( "Decimal", IsDecimal, lexical::IsDecimal, 
+        { "-1", "-12345678901234567890" } );
+    compare( "HexaDecimal", IsHexaDecimal, lexical::IsHexaDecimal, 
+        { "0x1", "0x0123456789abcdefABCDEF" } );
+    compare( "FloatingPoint", IsFloatingPoint, lexical::IsFloatingPoint, 
+        { "1.5", "-1234567890.0987654321" } );
+    compare( "Identifier", IsIdentifier, lexical::IsIdentifier, 
+        { "x", "a_rather_long_identifier_name_12345" } );
+    compare( "WindowsPath", IsWindowsPath, lexical::IsWindowsPath, 
+        { "C:\\x", "C:\\Program Files\\Some Vendor\\Some Product\\bin\\app.exe" } );
+    compare( "UnixPath", IsUnixPath, lexical::IsUnixPath, 
+        { "/x", "/home/elrat/projects/clp/build/benchmarks/parametertypes" } );
+    compare( "EmailAddress", IsEmailAddress, lexical::IsEmailAddress, 
+        { "a@b.c", "firstname.lastname-work@mail.some-company.example.com" } );
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace elrat::clp;
+
+// A script of 10M lines (or as many as the first argument says), processed
+// line by line, as a batch and as a pipeline. The pipeline needs three
+// cores to pay off.
+int main(int argc, char** argv)
+{
+    using Clock = std::chrono::steady_clock;
+    const std::size_t count{ argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 10000000ul };
+
+    Processor processor;
+    for( int i{0}; i < 100; i++ )
+        processor.attach(
+            CommandDescriptor::Create( "command-" + std::to_string(i), "", {
+                TypedParameterDescriptor<int>::Create("n", "", Mandatory, { AtLeast(0) }) },{
+                OptionDescriptor::Create("verbose") }),
+            [](const CommandLineView& cmdline) { keep(cmdline); } );
+
+    // One buffer for the script, to keep its size in check
+    std::string script;
+    std::vector<std::size_t> ends;
+    ends.reserve( count );
+    for( std::size_t i{0}; i < count; i++ )
+    {
+        // Runs of lines for the same command, like a generated script
+        script += "command-" + std::to_string( i / 8 % 100 ) + " " 
+            + std::to_string( i % 1000 ) + ( i % 3 ? "" : " --verbose" );
+        ends.push_back( script.size() );
+    }
+    std::vector<std::string_view> lines;
+    lines.reserve( count );
+    std::size_t begin{0};
+    for( auto end : ends )
+    {
+        lines.emplace_back( script.data() + begin, end - begin );
+        begin = end;
+    }
+
+    auto run{ [&](const std::string& label, auto function) {
+        const auto start{ Clock::now() };
+        function();
+        const std::chrono::duration<double> elapsed{ Clock::now() - start };
+        report( label, count / elapsed.count() / 1e6, "Mlines/s" );
+    }};
+    run( "Processor::process", [&]{
+        std::string line;
+        for( auto view : lines )
+        {
+            line.assign( view );
+            processor.process( line );
+        }
+    });
+    run( "Processor::processBatch", [&]{ keep( processor.processBatch(lines) ); } );
+    run( "Processor::processPipelined", [&]{ keep( processor.processPipelined(lines) ); } );
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/descriptors.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace elrat::clp;
+
+// How DescriptorMap::attach detected duplicates before: by comparing the
+// new descriptor with every attached one.
+static void attachQuadratic(CommandDescriptors& attached, CommandDescriptorPtr p)
+{
+    for( auto& descriptor : attached )
+        if ( p == descriptor || p->getName() == descriptor->getName() )
+            throw AlreadyInUseException( p->getName() );
+    attached.push_back(p);
+}
+
+int main()
+{
+    for( std::size_t count : { 1000, 10000, 100000 } )
+    {
+        CommandDescriptors descriptors;
+        for( std::size_t i{0}; i < count; i++ )
+            descriptors.push_back( CommandDescriptor::Create( "command-" + std::to_string(i) ) );
+
+        std::cout << count << " descriptors\n";
+        // Quadratic registration of 100k descriptors takes too long.
+        if ( count <= 10000 )
+            report( "  linear duplicate check", measure( 1, [&]{
+                CommandDescriptors attached;
+                for( auto& p : descriptors )
+                    attachQuadratic( attached, p );
+                keep( attached );
+            }) / 1e6, "ms" );
+        report( "  attach, one by one", measure( 1, [&]{
+            DescriptorMap map;
+            for( auto& p : descriptors )
+                map.attach( p );
+            keep( map );
+        }) / 1e6, "ms" );
+        report( "  attach, bulk", measure( 1, [&]{
+            DescriptorMap map;
+            map.attach( descriptors );
+            keep( map );
+        }) / 1e6, "ms" );
+    }
+    return 0;
+}
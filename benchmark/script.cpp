@@ -0,0 +1,59 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace elrat::clp;
+
+// A script of 10M lines (or as many as the first argument says), read with
+// std::getline and passed to process(), and run by runFile().
+int main(int argc, char** argv)
+{
+    using Clock = std::chrono::steady_clock;
+    const std::size_t count{ argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 10000000ul };
+
+    Processor processor;
+    for( int i{0}; i < 100; i++ )
+        processor.attach(
+            CommandDescriptor::Create( "command-" + std::to_string(i), "", {
+                TypedParameterDescriptor<int>::Create("n", "", Mandatory, { AtLeast(0) }) },{
+                OptionDescriptor::Create("verbose") }),
+            [](const CommandLineView& cmdline) { keep(cmdline); } );
+
+    const auto path{ ( std::filesystem::temp_directory_path() / "clp-script-benchmark" ).string() };
+    {
+        std::ofstream script( path );
+        for( std::size_t i{0}; i < count; i++ )
+            script << "command-" << i / 8 % 100 << ' ' << i % 1000 
+                << ( i % 3 ? "" : " --verbose" ) << '\n';
+    }
+
+    {
+        const auto start{ Clock::now() };
+        std::ifstream script( path );
+        std::string line;
+        while( std::getline( script, line ) )
+        {
+            try
+            {
+                processor.process( line );
+            }
+            catch( const Exception& )
+            {
+            }
+        }
+        const std::chrono::duration<double> elapsed{ Clock::now() - start };
+        report( "std::getline + Processor::process", count / elapsed.count() / 1e6, "Mlines/s" );
+    }
+    const auto stats{ processor.runFile( path ) };
+    report( "Processor::runFile", stats.processed / stats.seconds / 1e6, "Mlines/s" );
+    report( "Processor::runFile", stats.bytes / stats.seconds / 1e6, "MB/s" );
+    std::remove( path.c_str() );
+    return 0;
+}
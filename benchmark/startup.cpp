@@ -0,0 +1,68 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <string>
+
+using namespace elrat::clp;
+
+namespace
+{
+    const char* const argv[]{ 
+        "tool", "copy", "--recursive", "-fv", "--bandwidth=1000", "source", "target" };
+    const int argc{ sizeof(argv) / sizeof(argv[0]) };
+
+    // What a command line tool configures on every start
+    void configure(Processor& processor)
+    {
+        for( int i{0}; i < 20; i++ )
+            processor.attach(
+                CommandDescriptor::Create( i ? "command-" + std::to_string(i) : "copy", "", {
+                    ParameterDescriptor::Create("source"),
+                    ParameterDescriptor::Create("target") },{
+                    OptionDescriptor::Create("recursive"),
+                    OptionDescriptor::Create("f"),
+                    OptionDescriptor::Create("v"),
+                    OptionDescriptor::Create("bandwidth", "", {
+                        TypedParameterDescriptor<int>::Create("kbps") }) }),
+                [](const CommandLineView& cmdline) { keep(cmdline); } );
+    }
+
+    std::string join(int count, const char* const* arguments)
+    {
+        std::string line;
+        for( int i{0}; i < count; i++ )
+            line.append( i ? " " : "" ).append( arguments[i] );
+        return line;
+    }
+}
+
+// The start of a short-lived command line tool: parsing its arguments, and
+// all of it (creating and configuring a processor, then processing them).
+// The arguments are either joined into a line or passed as they are.
+int main()
+{
+    const std::size_t iterations{ 20000 };
+    NativeParser parser;
+    CommandLineView view;
+    report( "join + NativeParser::parse(string)",
+        measure( iterations * 10, [&]{ keep( parser.parse( join( argc - 1, argv + 1 ) ) ); } ) );
+    report( "NativeParser::parse(argc, argv)",
+        measure( iterations * 10, [&]{ keep( parser.parse( argc - 1, argv + 1 ) ); } ) );
+    report( "NativeParser::tryParse(argc, argv, view)",
+        measure( iterations * 10, [&]{ keep( parser.tryParse( argc - 1, argv + 1, view ) ); } ) );
+
+    report( "startup, join + Processor::process(string)",
+        measure( iterations, [&]{ 
+            Processor processor;
+            configure( processor );
+            processor.process( join( argc - 1, argv + 1 ) );
+        }));
+    report( "startup, Processor::process(argc, argv)",
+        measure( iterations, [&]{ 
+            Processor processor;
+            configure( processor );
+            processor.process( argc - 1, argv + 1 );
+        }));
+    return 0;
+}
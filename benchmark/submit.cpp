@@ -0,0 +1,87 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/processor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace elrat::clp;
+
+// Lines, whose commands wait for 1 ms (like I/O), processed one after the
+// other and submitted to executors with 1, 2, 4, ... threads. The maximum
+// number of threads is the first argument (default: 16). Then the overhead
+// of submitting a line, whose command does nothing.
+int main(int argc, char** argv)
+{
+    using Clock = std::chrono::steady_clock;
+    Processor processor;
+    for( int i{0}; i < 10; i++ )
+        processor.attach(
+            CommandDescriptor::Create( "wait-" + std::to_string(i), "", {
+                TypedParameterDescriptor<int>::Create("n") }),
+            [](const CommandLineView& cmdline) { 
+                keep(cmdline);
+                std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+            });
+    processor.attach(
+        CommandDescriptor::Create( "nothing", "", {
+            TypedParameterDescriptor<int>::Create("n") }),
+        [](const CommandLineView& cmdline) { keep(cmdline); });
+
+    std::vector<std::string> lines;
+    for( int i{0}; i < 200; i++ )
+        lines.push_back( "wait-" + std::to_string( i % 10 ) + " " + std::to_string(i) );
+
+    const auto start{ Clock::now() };
+    for( auto& line : lines )
+        processor.process(line);
+    const std::chrono::duration<double> elapsed{ Clock::now() - start };
+    report( "Processor::process, 1 ms commands", lines.size() / elapsed.count(), "lines/s" );
+
+    const unsigned max_threads{ argc > 1 ? static_cast<unsigned>( std::atoi(argv[1]) ) : 16u };
+    for( unsigned threads{1}; threads <= max_threads; threads *= 2 )
+    {
+        processor.setExecutor( Executor::Create(threads) );
+        for( auto ordering : { Ordering::None, Ordering::PerCommand } )
+        {
+            const auto start{ Clock::now() };
+            for( auto& line : lines )
+                processor.submit( line, [](const Diagnostic&, std::exception_ptr) {}, ordering );
+            processor.drain();
+            const std::chrono::duration<double> elapsed{ Clock::now() - start };
+            report(
+                std::string("Processor::submit, ") 
+                    + ( ordering == Ordering::None ? "unordered, " : "per command, " )
+                    + std::to_string(threads) + " thread(s)",
+                lines.size() / elapsed.count(),
+                "lines/s" );
+        }
+        if ( threads < max_threads && threads * 2 > max_threads )
+            threads = max_threads / 2;
+    }
+
+    processor.setExecutor( Executor::Create() );
+    const std::size_t iterations{ 200000 };
+    const std::string line{ "nothing 1" };
+    report( "Processor::tryProcess, empty command",
+        measure( iterations, [&]{ keep( processor.tryProcess(line).getCode() ); } ) );
+    const auto submit{ measure( iterations, [&]{
+        processor.submit( line, [](const Diagnostic& diagnostic, std::exception_ptr) {
+            keep( diagnostic.getCode() );
+        });
+    }) };
+    processor.drain();
+    report( "Processor::submit, empty command", submit );
+    std::vector<std::future<Diagnostic>> futures;
+    futures.reserve( iterations );
+    report( "Processor::submit (future), empty command",
+        measure( iterations, [&]{ futures.push_back( processor.submit(line) ); } ) );
+    for( auto& future : futures )
+        keep( future.get().getCode() );
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "allocationcounter.hpp"
+#include "benchmark.hpp"
+
+#include "elrat/clp/commandline.hpp"
+#include "elrat/clp/commandlineview.hpp"
+#include "elrat/clp/nativeparser.hpp"
+
+#include <string>
+#include <vector>
+
+int main()
+{
+    const std::size_t iterations{ 100000 };
+    const std::vector<std::string> inputs {
+         "x"
+        ,"x --a=1 --b=2 --c=3"
+        ,"tar -cvf --file = archive.tar a b c"
+    };
+    elrat::clp::NativeParser parser;
+    elrat::clp::CommandLineView reused;
+    for( auto& input : inputs )
+    {
+        std::cout << "[" << input << "]\n";
+        // Warm up the reused view, so it has reached its final capacity.
+        parser.parse( input, reused );
+
+        auto parse_reused{ [&]{ parser.parse( input, reused ); keep(reused); } };
+        auto parse_fresh{ [&]{ elrat::clp::CommandLineView view; parser.parse( input, view ); keep(view); } };
+        auto parse_copy{ [&]{ keep( parser.parse(input) ); } };
+        auto copy_view{ [&]{ keep( elrat::clp::CommandLine(reused) ); } };
+
+        report( "  allocations, reused CommandLineView", countAllocations( iterations, parse_reused ), "/parse" );
+        report( "  allocations, new CommandLineView", countAllocations( iterations, parse_fresh ), "/parse" );
+        report( "  allocations, CommandLine", countAllocations( iterations, parse_copy ), "/parse" );
+        report( "  allocations, CommandLine from view", countAllocations( iterations, copy_view ), "/copy" );
+        report( "  duration, reused CommandLineView", measure( iterations, parse_reused ) );
+        report( "  duration, new CommandLineView", measure( iterations, parse_fresh ) );
+        report( "  duration, CommandLine", measure( iterations, parse_copy ) );
+        report( "  duration, CommandLine from view", measure( iterations, copy_view ) );
+    }
+    return 0;
+}
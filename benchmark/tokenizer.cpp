@@ -0,0 +1,56 @@
+#include "benchmark.hpp"
+
+#include "elrat/clp/nativeparser.hpp"
+#include "parser/nativeparser/tokenizer.hpp"
+
+#include <regex>
+#include <string>
+#include <vector>
+
+// The tokenizer, that was used by the NativeParser before.
+static std::vector<std::string> tokenizeRegex(const std::string& input)
+{
+    std::vector<std::string> result{};
+    std::regex separating_regex("(\"[^\"]+\")|([^\\s=]+)|(=)");
+    auto begin{ std::sregex_iterator(input.begin(), input.end(), separating_regex) };
+    auto end{ std::sregex_iterator() };
+    for( auto it{begin}; it!=end; it++ )
+        result.push_back( it->str() );
+    return result;
+}
+
+static std::vector<std::string> tokenizeSinglePass(const std::string& input)
+{
+    std::vector<std::string> result{};
+    Tokenizer tokenizer(input);
+    std::string_view token;
+    while( tokenizer.next(token) )
+        result.emplace_back( token );
+    return result;
+}
+
+int main()
+{
+    const std::size_t iterations{ 100000 };
+    const std::vector<std::string> inputs {
+         "x"
+        ,"sayhello World --shout"
+        ,"x --a=1 --b=2 --c=3"
+        ,"copy \"C:\\Program Files\\a.exe\" \"/home/elrat/some file\" -rfv --mode = fast"
+    };
+    elrat::clp::NativeParser parser;
+    for( auto& input : inputs )
+    {
+        std::cout << "[" << input << "]\n";
+        report( "  tokenize (std::regex)", measure( iterations, [&]{ 
+            keep( tokenizeRegex(input) ); 
+        }));
+        report( "  tokenize (single pass)", measure( iterations, [&]{ 
+            keep( tokenizeSinglePass(input) ); 
+        }));
+        report( "  NativeParser::parse", measure( iterations, [&]{ 
+            keep( parser.parse(input) ); 
+        }));
+    }
+    return 0;
+}
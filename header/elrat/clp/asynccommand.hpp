@@ -0,0 +1,31 @@
+#ifndef ELRAT_CLP_ASYNCCOMMAND_HPP
+#define ELRAT_CLP_ASYNCCOMMAND_HPP
+
+#include <elrat/clp/asynctask.hpp>
+#include <elrat/clp/command.hpp>
+
+namespace elrat {
+namespace clp {
+
+// Command, that may wait (for files, sockets, ...) without blocking a 
+// thread. Processor::submit() starts the coroutine on the executor; while
+// it is suspended, the executor's threads process other lines.
+class AsyncCommand
+: public Command
+{
+public:
+    using Command::execute;
+
+    // The command line is a copy, as the coroutine may outlive the input.
+    virtual AsyncTask executeAsync(CommandLine) = 0;
+
+    // Invoked by process(), tryProcess() and processBatch(): runs the 
+    // coroutine and blocks until it has finished. It is continued by the
+    // thread, that resumes it, so that thread must not be blocked here.
+    void execute(const CommandLine&) override;
+};
+
+} // clp
+} // elrat
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef ELRAT_CLP_ASYNCTASK_HPP
+#define ELRAT_CLP_ASYNCTASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+
+#include <elrat/clp/executor.hpp>
+
+namespace elrat {
+namespace clp {
+
+// Coroutine of an asynchronous command. It is created suspended. Either it
+// is started, or another AsyncTask awaits it, which runs it to its end and
+// passes on its exception.
+class AsyncTask
+{
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+    using Completion = std::function<void(std::exception_ptr)>;
+
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type
+    {
+        std::coroutine_handle<> continuation;   // the awaiting coroutine
+        Executor*               executor{ nullptr };
+        Completion              completion;     // of a started coroutine
+        std::exception_ptr      exception;
+
+        AsyncTask get_return_object() { return AsyncTask( Handle::from_promise(*this) ); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    AsyncTask(AsyncTask&&) noexcept;
+    AsyncTask& operator=(AsyncTask&&) noexcept;
+    AsyncTask(const AsyncTask&)=delete;
+    AsyncTask& operator=(const AsyncTask&)=delete;
+    // Destroys the coroutine, unless it has been started
+    ~AsyncTask();
+
+    // Runs the coroutine on the calling thread, until it is suspended. It
+    // is continued on the executor then, or by the resuming thread, if the
+    // executor is null. The completion is called with the exception of the
+    // coroutine (null, if it had none) once it has finished; it must not
+    // throw. The task is empty afterwards.
+    void start(Executor*, Completion);
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(Handle) noexcept;
+    void await_resume() const;
+private:
+    explicit AsyncTask(Handle);
+    Handle handle;
+};
+
+// Continues a coroutine, that has been suspended by suspend(), on its
+// executor. It must be called exactly once, from any thread.
+class Resumer
+{
+public:
+    Resumer(Executor*, std::coroutine_handle<>);
+    void operator()() const;
+private:
+    Executor*               executor;
+    std::coroutine_handle<> handle;
+};
+
+// Suspends the coroutine and calls the function with its Resumer, e.g. to
+// register it as the callback of an I/O operation:
+//
+//      co_await suspend( [&](Resumer resume){ socket.onReadable(resume); } );
+template <class FUNCTION>
+struct Suspension
+{
+    FUNCTION function;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(AsyncTask::Handle handle)
+    {
+        // The coroutine, and this awaiter with it, may be continued and
+        // destroyed before the function returns.
+        auto f{ std::move(function) };
+        f( Resumer( handle.promise().executor, handle ) );
+    }
+    void await_resume() const noexcept {}
+};
+
+template <class FUNCTION>
+Suspension<FUNCTION> suspend(FUNCTION function)
+{
+    return { std::move(function) };
+}
+
+// Continues the coroutine on its executor, behind the tasks waiting there.
+// Without an executor, it just goes on.
+struct Rescheduling
+{
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(AsyncTask::Handle);
+    void await_resume() const noexcept {}
+};
+
+inline Rescheduling reschedule()
+{
+    return {};
+}
+
+} // clp
+} // elrat
+
+#endif
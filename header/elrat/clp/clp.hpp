@@ -1,16 +1,25 @@
 #ifndef ELRAT_CLP_CLP_HPP
 #define ELRAT_CLP_CLP_HPP
 
+#include <elrat/clp/asynccommand.hpp>
+#include <elrat/clp/asynctask.hpp>
 #include <elrat/clp/command.hpp>
 #include <elrat/clp/commandline.hpp>
+#include <elrat/clp/commandlineview.hpp>
 #include <elrat/clp/commandmap.hpp>
 #include <elrat/clp/convert.hpp>
 #include <elrat/clp/descriptors.hpp>
+#include <elrat/clp/diagnostic.hpp>
 #include <elrat/clp/errorhandling.hpp>
+#include <elrat/clp/executor.hpp>
 #include <elrat/clp/nativeparser.hpp>
 #include <elrat/clp/parser.hpp>
 #include <elrat/clp/parserwrapper.hpp>
 #include <elrat/clp/processor.hpp>
+#include <elrat/clp/smallvector.hpp>
+#include <elrat/clp/stringmap.hpp>
+#include <elrat/clp/symbolmap.hpp>
+#include <elrat/clp/symbols.hpp>
 
 #endif
 
@@ -4,6 +4,7 @@
 #include <memory>
 
 #include <elrat/clp/commandline.hpp>
+#include <elrat/clp/commandlineview.hpp>
 
 namespace elrat {
 namespace clp {
@@ -23,6 +24,10 @@ public:
 
     virtual ~Command();
     virtual void execute(const CommandLine&) = 0;
+
+    // Invoked by the processor, if the parser provides views. Override it to
+    // avoid the copy into a CommandLine, that the default implementation makes.
+    virtual void execute(const CommandLineView&);
 };
 
 
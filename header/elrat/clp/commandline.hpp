@@ -2,70 +2,171 @@
 #define ELRAT_CLP_COMMANDLINE_HPP
 
 #include <elrat/clp/convert.hpp>
+#include <elrat/clp/smallvector.hpp>
+#include <elrat/clp/symbols.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace elrat {
 namespace clp {
 
+class CommandLineView;
+
+// The text of all tokens is kept in a single buffer; the command, the 
+// parameters and the options refer to it by offsets. Typical lines fit into 
+// the inline capacity of the buffers and don't allocate at all. Longer ones
+// allocate from the memory resource of the command line.
 class CommandLine
 {
+    struct Token
+    {
+        std::uint32_t begin;
+        std::uint32_t size;
+    };
 public:
+    // Copies of the parameters, and of the options with theirs
     using Parameters = std::vector<std::string>;
     using Options = std::vector<std::pair<std::string,Parameters>>;
+    class TextRange;
+
+    CommandLine() = default;
+    explicit CommandLine(std::pmr::memory_resource*);
+    explicit CommandLine(const CommandLineView&);
+
+    std::pmr::memory_resource* getMemoryResource() const;
     
     operator bool() const;
     
-    const std::string& getCommand() const;
+    // Copies of the tokens. The *Text accessors below return views into
+    // the buffer instead, which don't allocate.
+    std::string getCommand() const;
     
-    bool optionExists(const std::string&) const;
+    bool optionExists(std::string_view) const;
     int getOptionCount() const;
-    const std::string& getOption(int) const;
+    std::string getOption(int) const;
     
-    const Parameters& getCommandParameters() const;
-    const std::string& getCommandParameter(int) const;
-    const Parameters& getOptionParameters(const std::string&) const;
-    const Parameters& getOptionParameters(int) const;
+    Parameters getCommandParameters() const;
+    std::string getCommandParameter(int) const;
+    Parameters getOptionParameters(std::string_view) const;
+    Parameters getOptionParameters(int) const;
+
+    // The tokens, valid until the command line is changed. CommandLineView
+    // has the same accessors, for code written for both.
+    std::string_view getCommandText() const;
+    std::string_view getOptionText(int) const;
+    std::string_view getCommandParameterText(int) const;
+    TextRange getCommandParameterTexts() const;
+    TextRange getOptionParameterTexts(std::string_view) const;
+    TextRange getOptionParameterTexts(int) const;
+
+    // Symbols of the names, resolved when they are set (NoSymbol for names,
+    // that haven't been interned then)
+    Symbol getCommandSymbol() const;
+    Symbol getOptionSymbol(int) const;
+    // Index of the option, -1 if there is none (or its name had no symbol
+    // when it was added)
+    int getOptionIndex(Symbol) const;
 
     template <class T> T getCommandParameterAs(int) const;
-    template <class T> T getOptionParameterAs(const std::string&,int) const;
+    template <class T> T getOptionParameterAs(std::string_view,int) const;
     template <class T> T getOptionParameterAs(int,int) const;
 
-    void setCommand(const std::string&);
-    void addCommandParameter(const std::string&);
-    void addOption(const std::string&);
-    void addOptionParameter(const std::string&); // last inserted option
+    void setCommand(std::string_view);
+    void addCommandParameter(std::string_view);
+    void addOption(std::string_view);
+    void addOptionParameter(std::string_view); // last inserted option
+
+    // Empties the command line, but keeps the allocated capacity.
+    void clear();
+    // Copies the view into the buffers, which keep their capacity
+    void assign(const CommandLineView&);
+private:
+    struct Option
+    {
+        Token         name;
+        Symbol        symbol;
+        std::uint32_t first_parameter;
+        std::uint32_t parameter_count;
+    };
+
+    SmallVector<char,64>  text;
+    Token                 command{0,0};
+    Symbol                command_symbol{ NoSymbol };
+    SmallVector<Token,4>  parameters;
+    SmallVector<Option,4> options;
+    SmallVector<Token,4>  option_parameters;
+
+    void setCommand(std::string_view, Symbol);
+    void addOption(std::string_view, Symbol);
+    Token store(std::string_view);
+    std::string_view tokenText(Token) const;
+    int findOption(std::string_view) const;
+};
+
+// The parameters of the command or an option, as a range of views into the
+// buffer of the command line.
+class CommandLine::TextRange
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        const_iterator() = default;
+        const_iterator(const char* t, const Token* p) : text{t}, position{p} {}
+        std::string_view operator*() const { return { text + position->begin, position->size }; }
+        const_iterator& operator++() { ++position; return *this; }
+        const_iterator operator++(int) { auto previous{ *this }; ++position; return previous; }
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+    private:
+        const char*  text{ nullptr };
+        const Token* position{ nullptr };
+    };
+    using value_type = std::string_view;
+
+    TextRange(const char* text = nullptr, const Token* first = nullptr, std::size_t count = 0);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    std::size_t size() const;
+    bool empty() const;
+    std::string_view operator[](std::size_t) const;
+    std::string_view at(std::size_t) const;
 private:
-    std::string command;
-    Parameters  parameters;
-    Options     options;
+    const char*  text;
+    const Token* first;
+    std::size_t  count;
 };
 
 template <class T> 
 T CommandLine::getCommandParameterAs(int param_index) const
 {
-    return convert<T>( parameters.at(param_index) );
+    return convert<T>( getCommandParameterText(param_index) );
 }
 
 template <class T> 
-T CommandLine::getOptionParameterAs(const std::string& opt_name,int param_index) const
+T CommandLine::getOptionParameterAs(std::string_view opt_name,int param_index) const
 {
-    int opt_index{-1};
-    for( int i{0}; i < options.size(); i++)
-        if ( options[i].first == opt_name )
-        {
-            opt_index = i;
-            break;
-        }
-    return getOptionParameterAs<T>(opt_index,param_index);
+    return getOptionParameterAs<T>(findOption(opt_name),param_index);
 }
 
 template <class T> 
 T CommandLine::getOptionParameterAs(int opt_index, int param_index) const
 {
-    return convert<T>( options.at(opt_index).second.at(param_index) );
+    return convert<T>( getOptionParameterTexts(opt_index).at(param_index) );
 }
 
 } // clp
@@ -0,0 +1,151 @@
+#ifndef ELRAT_CLP_COMMANDLINEVIEW_HPP
+#define ELRAT_CLP_COMMANDLINEVIEW_HPP
+
+#include <elrat/clp/convert.hpp>
+#include <elrat/clp/symbols.hpp>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace elrat {
+namespace clp {
+
+class CommandLine;
+class OptionDescriptor;
+
+// Same structure as CommandLine, but the tokens refer to a buffer owned by
+// someone else (usually the input string of the parser). The buffer must
+// outlive the view. The view's own arrays come from its memory resource.
+class CommandLineView
+{
+public:
+    class Parameters;
+
+    CommandLineView() = default;
+    explicit CommandLineView(std::pmr::memory_resource*);
+    explicit CommandLineView(const CommandLine&);
+
+    std::pmr::memory_resource* getMemoryResource() const;
+
+    operator bool() const;
+
+    std::string_view getCommand() const;
+
+    bool optionExists(std::string_view) const;
+    int getOptionCount() const;
+    std::string_view getOption(int) const;
+
+    // Symbols of the names, resolved when they are set (NoSymbol for names,
+    // that haven't been interned then)
+    Symbol getCommandSymbol() const;
+    Symbol getOptionSymbol(int) const;
+    // Index of the option, -1 if there is none (or its name had no symbol
+    // when it was added)
+    int getOptionIndex(Symbol) const;
+
+    Parameters getCommandParameters() const;
+    std::string_view getCommandParameter(int) const;
+    Parameters getOptionParameters(std::string_view) const;
+    Parameters getOptionParameters(int) const;
+
+    // The same, under the names of CommandLine's accessors, that don't copy
+    std::string_view getCommandText() const;
+    std::string_view getOptionText(int) const;
+    std::string_view getCommandParameterText(int) const;
+    Parameters getCommandParameterTexts() const;
+    Parameters getOptionParameterTexts(std::string_view) const;
+    Parameters getOptionParameterTexts(int) const;
+
+    // Typed values of the parameters, set by the validation of typed
+    // parameter descriptors (std::monostate otherwise).
+    const Value& getCommandParameterValue(int) const;
+    const Value& getOptionParameterValue(int,int) const;
+    Value* getCommandParameterValues();
+    Value* getOptionParameterValues(int);
+
+    // The descriptor, that matched the option during the validation
+    // (nullptr, if the view hasn't been validated)
+    const OptionDescriptor* getOptionDescriptor(int) const;
+    void setOptionDescriptor(int, const OptionDescriptor*);
+
+    template <class T> T getCommandParameterAs(int) const;
+    template <class T> T getOptionParameterAs(std::string_view,int) const;
+    template <class T> T getOptionParameterAs(int,int) const;
+
+    void setCommand(std::string_view);
+    void addCommandParameter(std::string_view);
+    void addOption(std::string_view);
+    void addOptionParameter(std::string_view); // last inserted option
+
+    // Empties the view, but keeps the allocated capacity.
+    void clear();
+private:
+    struct Option
+    {
+        std::string_view name;
+        Symbol symbol;
+        std::size_t first_parameter;
+        std::size_t parameter_count;
+        const OptionDescriptor* descriptor;
+    };
+
+    std::string_view                   command;
+    Symbol                             command_symbol{ NoSymbol };
+    std::pmr::vector<std::string_view> parameters;
+    std::pmr::vector<Option>           options;
+    std::pmr::vector<std::string_view> option_parameters;
+    std::pmr::vector<Value>            parameter_values;        // parallel to parameters
+    std::pmr::vector<Value>            option_parameter_values; // parallel to option_parameters
+
+    int findOption(std::string_view) const;
+    void addOption(std::string_view, Symbol);
+};
+
+// Read-only range of parameters, valid until the view is modified.
+class CommandLineView::Parameters
+{
+public:
+    using value_type = std::string_view;
+    using const_iterator = const std::string_view*;
+
+    Parameters(const std::string_view* first = nullptr, std::size_t count = 0);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    std::size_t size() const;
+    bool empty() const;
+    std::string_view operator[](std::size_t) const;
+    std::string_view at(std::size_t) const;
+private:
+    const std::string_view* first;
+    std::size_t count;
+};
+
+template <class T>
+T CommandLineView::getCommandParameterAs(int param_index) const
+{
+    return convert<T>( 
+        getCommandParameter(param_index),
+        getCommandParameterValue(param_index) );
+}
+
+template <class T>
+T CommandLineView::getOptionParameterAs(std::string_view opt_name, int param_index) const
+{
+    return getOptionParameterAs<T>( findOption(opt_name), param_index );
+}
+
+template <class T>
+T CommandLineView::getOptionParameterAs(int opt_index, int param_index) const
+{
+    return convert<T>( 
+        getOptionParameters(opt_index).at(param_index),
+        getOptionParameterValue(opt_index, param_index) );
+}
+
+} // clp
+} // elrat
+
+#endif
@@ -2,32 +2,58 @@
 #define ELRAT_CLP_COMMANDMAP_HPP
 
 #include <elrat/clp/commandline.hpp>
+#include <elrat/clp/commandlineview.hpp>
 #include <elrat/clp/command.hpp>
+#include <elrat/clp/descriptors.hpp>
+#include <elrat/clp/symbolmap.hpp>
+#include <elrat/clp/symbols.hpp>
 
-#include <functional>
-#include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace elrat {
 namespace clp {
 
+// Dispatch table, that resolves a command name with a single lookup to
+// its descriptor and the commands, that handle it. The names are interned
+// when they are attached; the entries are found by their symbols.
 class CommandMap 
 {
 public:
+    struct Entry
+    {
+        const CommandDescriptor* descriptor{nullptr};
+        std::vector<CommandPtr>  commands;
+    };
+
     void attach(const std::string& name, CommandPtr);
+    // Assigns the descriptor to its name, unless the name has one already.
+    // The descriptor must outlive the map.
+    void attach(const CommandDescriptorPtr&);
     void detach(const std::string& name, CommandPtr = nullptr);
+    // nullptr, if neither a descriptor nor a command has been attached to
+    // the name. Attaching and detaching invalidate the entry.
+    const Entry* find(std::string_view) const;
+    const Entry* find(Symbol) const;
+    // By the command's symbol, or its name, if it has none
+    const Entry* find(const CommandLine&) const;
+    const Entry* find(const CommandLineView&) const;
     void invoke(const CommandLine&) const;
+    void invoke(const CommandLineView&) const;
+    void invoke(const Entry&, const CommandLine&) const;
+    void invoke(const Entry&, const CommandLineView&) const;
 private:
-    std::map<std::string, std::vector<CommandPtr>> commands;
+    SymbolMap<Entry> entries;
+
+    template <class COMMANDLINE> const Entry* findEntry(const COMMANDLINE&) const;
 
     void throwIfEmpty(const std::string& candidate, const std::string& where);
     void throwIfNull(CommandPtr candidate, const std::string& where);
-    const std::vector<CommandPtr>& find(const std::string&) const;
+    template <class COMMANDLINE> const Entry& findCommands(const COMMANDLINE&) const;
 };
 
 } // clp
 } // elrat
 
 #endif
-
@@ -1,27 +1,221 @@
 #ifndef ELRAT_CLP_CONVERT_HPP
 #define ELRAT_CLP_CONVERT_HPP
 
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include <elrat/clp/errorhandling.hpp>
 
 namespace elrat {
 namespace clp {
 
+// Typed value of an argument, as determined by a typed parameter descriptor.
+// Integers are stored sign-dependent with 64 bit, floating point numbers as
+// double. Arguments without typed descriptor hold std::monostate.
+using Value = std::variant<std::monostate, std::int64_t, std::uint64_t, double>;
+
+// Numbers are converted with parseNumber, and a text that isn't a number
+// of type T raises an InvalidParameterTypeException. Other types are read
+// from a stringstream.
+template <class T> T convert(std::string_view);
+template <> const char* convert<const char*>(std::string_view);
+// For callers (and specializations) written for std::string
 template <class T> T convert(const std::string&);
-template <> const char* convert<const char*>(const std::string&);
+template <class T> T convert(const char*);
+
+// Same, but returns false instead of raising an exception.
+template <class T> bool convert(std::string_view, T&);
+
+// Uses the value, if it was set, and converts the text otherwise.
+template <class T> T convert(std::string_view, const Value&);
+template <class T> bool convert(std::string_view, const Value&, T&);
+
+// Stores the value in the result, if it is set and T can represent it 
+// (integers without wrapping around, floating point numbers within the 
+// range of T). Returns false otherwise.
+template <class T> bool convertValue(const Value&, T&);
+
+// Numbers that can be parsed by std::from_chars. Neither bool nor the
+// character types are numbers here.
+template <class T>
+constexpr bool is_number_v =
+       std::is_arithmetic_v<T>
+    && !std::is_same_v<T,bool>
+    && !std::is_same_v<T,char>
+    && !std::is_same_v<T,signed char>
+    && !std::is_same_v<T,unsigned char>
+    && !std::is_same_v<T,wchar_t>
+    && !std::is_same_v<T,char16_t>
+    && !std::is_same_v<T,char32_t>
+    && !std::is_same_v<T,long double>;
+
+// Parses the whole text as number. Accepted are
+//  - integers: [+-]?\d+ (no minus for unsigned types) or 0[xX][0-9a-fA-F]+,
+//  - floating point numbers: [+-]?(\d+\.?\d*|\.\d+)([eE][+-]?\d+)?
+// Returns false, if the text has another form or is out of range.
+template <class T> bool parseNumber(std::string_view, T&);
+
+// The type a number is stored as in a Value
+template <class T>
+using value_type_t =
+    std::conditional_t< std::is_floating_point_v<T>, double,
+    std::conditional_t< std::is_signed_v<T>, std::int64_t, std::uint64_t > >;
+
+// ---
+template <class T>
+T convert(std::string_view arg)
+{
+    if constexpr ( is_number_v<T> )
+    {
+        T result;
+        if ( !parseNumber(arg, result) )
+            throw InvalidParameterTypeException(std::string(arg));
+        return result;
+    }
+    else
+    {
+        std::stringstream ss;
+        ss << arg;
+        T result;
+        ss >> result;
+        return result;
+    }
+}
+
+template <class T>
+T convert(const std::string& arg)
+{
+    return convert<T>( std::string_view(arg) );
+}
+
+template <class T>
+T convert(const char* arg)
+{
+    return convert<T>( std::string_view(arg) );
+}
+
+template <class T>
+bool convert(std::string_view arg, T& result)
+{
+    if constexpr ( is_number_v<T> )
+    {
+        return parseNumber(arg, result);
+    }
+    else
+    {
+        std::stringstream ss;
+        ss << arg;
+        ss >> result;
+        return !ss.fail();
+    }
+}
+
+template <class T>
+T convert(std::string_view arg, const Value& value)
+{
+    if constexpr ( std::is_arithmetic_v<T> )
+    {
+        T result;
+        if ( convertValue(value, result) )
+            return result;
+    }
+    // Raises the same exception, if the value doesn't fit
+    return convert<T>(arg);
+}
 
-// --- 
-template <class T> 
-T convert(const std::string& arg) 
+template <class T>
+bool convert(std::string_view arg, const Value& value, T& result)
 {
-    std::stringstream ss;
-    ss << arg;
-    T result;
-    ss >> result;
-    return result;
+    if constexpr ( std::is_arithmetic_v<T> )
+    {
+        if ( convertValue(value, result) )
+            return true;
+    }
+    // Fails as well, if the value doesn't fit
+    return convert(arg, result);
+}
+
+template <class T>
+bool convertValue(const Value& value, T& result)
+{
+    static_assert( std::is_arithmetic_v<T>, "convertValue: T must be an arithmetic type" );
+    return std::visit( [&result](auto v) {
+        using V = decltype(v);
+        if constexpr ( std::is_same_v<V,std::monostate> )
+        {
+            return false;
+        }
+        else if constexpr ( std::is_integral_v<T> && std::is_floating_point_v<V> )
+        {
+            // Whole numbers in [min, max], which is [min, 2^digits)
+            if ( !( v == std::trunc(v) )
+              || v < static_cast<V>( std::numeric_limits<T>::min() )
+              || v >= std::ldexp( V{1}, std::numeric_limits<T>::digits ) )
+                return false;
+            result = static_cast<T>(v);
+            return true;
+        }
+        else if constexpr ( std::is_integral_v<T> )
+        {
+            const T t{ static_cast<T>(v) };
+            if ( static_cast<V>(t) != v || ( v < V{} ) != ( t < T{} ) )
+                return false;
+            result = t;
+            return true;
+        }
+        else
+        {
+            if constexpr ( std::is_floating_point_v<V> )
+            {
+                if ( std::isfinite(v) && std::fabs(v) > std::numeric_limits<T>::max() )
+                    return false;
+            }
+            result = static_cast<T>(v);
+            return true;
+        }
+    }, value );
+}
+
+template <class T>
+bool parseNumber(std::string_view s, T& result)
+{
+    static_assert( is_number_v<T>, "parseNumber: T must be an integer or floating point type" );
+    const char* last{ s.data() + s.size() };
+    std::from_chars_result r;
+    if constexpr ( std::is_integral_v<T> )
+    {
+        if ( s.size() > 2 && s[0] == '0' && ( s[1] == 'x' || s[1] == 'X' ) )
+        {
+            if ( s[2] == '-' )
+                return false;
+            r = std::from_chars( s.data() + 2, last, result, 16 );
+            return r.ec == std::errc{} && r.ptr == last;
+        }
+    }
+    // std::from_chars accepts a minus only and would also read "inf" or "nan"
+    const bool plus{ !s.empty() && s[0] == '+' };
+    if ( plus )
+        s.remove_prefix(1);
+    const std::size_t first{ ( !plus && !s.empty() && s[0] == '-' ) ? 1u : 0u };
+    if ( s.size() == first || s[first] == '+' || s[first] == '-' )
+        return false;
+    if constexpr ( std::is_floating_point_v<T> )
+    {
+        if ( s[first] != '.' && ( s[first] < '0' || s[first] > '9' ) )
+            return false;
+    }
+    r = std::from_chars( s.data(), last, result );
+    return r.ec == std::errc{} && r.ptr == last;
 }
 
 } // clp
 } // elrat
 
 #endif
-
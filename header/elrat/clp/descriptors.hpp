@@ -5,10 +5,17 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <elrat/clp/commandline.hpp>
+#include <elrat/clp/commandlineview.hpp>
+#include <elrat/clp/diagnostic.hpp>
 #include <elrat/clp/errorhandling.hpp>
+#include <elrat/clp/symbolmap.hpp>
+#include <elrat/clp/symbols.hpp>
 
 namespace elrat {
 namespace clp {
@@ -18,16 +25,35 @@ using DescriptorMapPtr = std::shared_ptr<DescriptorMap>;
 
 class CommandDescriptor;
 using CommandDescriptorPtr = std::shared_ptr<CommandDescriptor>;
+using CommandDescriptors = std::vector<CommandDescriptorPtr>;
 
 class OptionDescriptor;
 using OptionDescriptorPtr = std::shared_ptr<OptionDescriptor>;
 using OptionDescriptors = std::vector<OptionDescriptorPtr>;
 
 class ParameterDescriptor;
+template <class T> class TypedParameterDescriptor;
 using ParameterDescriptorPtr = std::shared_ptr<ParameterDescriptor>;
 using ParameterDescriptors = std::vector<ParameterDescriptorPtr>;
 
-using TypeChecker = std::function<bool(const std::string&)>;
+// Checks the text of an argument. Checkers, that take a const std::string&,
+// are accepted as well; they get a copy of the text.
+class TypeChecker
+: public std::function<bool(std::string_view)>
+{
+public:
+    using std::function<bool(std::string_view)>::function;
+    TypeChecker() = default;
+
+    template <class F, std::enable_if_t<
+           !std::is_invocable_r_v<bool, F&, std::string_view>
+        &&  std::is_invocable_r_v<bool, F&, const std::string&>, int> = 0>
+    TypeChecker(F f)
+    : std::function<bool(std::string_view)>( 
+        [f = std::move(f)](std::string_view s) mutable { return f( std::string(s) ); } )
+    {
+    }
+};
 
 class Constraint;
 using ConstraintPtr = std::shared_ptr<Constraint>;
@@ -41,14 +67,14 @@ extern const bool Optional;
 
 namespace ParameterType 
 {
-    bool Any(const std::string&);
-    bool NaturalNumber(const std::string&);
-    bool WholeNumber(const std::string&);
-    bool RealNumber(const std::string&);
-    bool Name(const std::string&);
-    bool Identifier(const std::string&);
-    bool Path(const std::string&);
-    bool EmailAddress(const std::string&);
+    bool Any(std::string_view);
+    bool NaturalNumber(std::string_view);
+    bool WholeNumber(std::string_view);
+    bool RealNumber(std::string_view);
+    bool Name(std::string_view);
+    bool Identifier(std::string_view);
+    bool Path(std::string_view);
+    bool EmailAddress(std::string_view);
 }
 
 template <class T> ConstraintPtr AtLeast(T&& t);
@@ -86,11 +112,21 @@ public:
     const ParameterDescriptors& getParameters() const;
     int getRequiredParameterCount() const;
     void validate(const Arguments&) const;
+    void validate(const CommandLine::TextRange&) const;
+    void validate(const CommandLineView::Parameters&) const;
+    // Also stores the typed values of the arguments (if 'values' isn't null)
+    void validate(const CommandLineView::Parameters&, Value* values) const;
+    // Same, but returns the diagnostic instead of throwing an exception
+    Diagnostic tryValidate(const Arguments&) const;
+    Diagnostic tryValidate(const CommandLine::TextRange&) const;
+    Diagnostic tryValidate(const CommandLineView::Parameters&, Value* values = nullptr) const;
 protected:
     ParameterDescriptors parameters;
     int numberOfRequiredParameters;
 
     void initialize();
+    template <class ARGUMENTS> void validateArguments(const ARGUMENTS&, Value*) const;
+    template <class ARGUMENTS> Diagnostic tryValidateArguments(const ARGUMENTS&, Value*) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -112,16 +148,44 @@ public:
         bool,
         TypeChecker,
         Constraints );
+    virtual ~ParameterDescriptor() = default;
     bool parameterIsRequired() const;
     TypeChecker getTypeChecker() const;
     const Constraints& getConstraints() const;
-    void validate(const Argument&) const;
+    // Returns the typed value of the argument (std::monostate if untyped)
+    Value validate(std::string_view) const;
+    // Same, but stores the value and returns the diagnostic instead of 
+    // throwing an exception
+    virtual Diagnostic tryValidate(std::string_view, Value&) const;
 private:
     bool        required;
     TypeChecker type_checker;
     Constraints constraints;
 };
 
+// Parses the argument into a number of type T once. The constraints get
+// the parsed value, and so does the command via the CommandLineView.
+// Accepts what parseNumber<T> accepts, e.g. hexadecimals for integers.
+template <class T>
+class TypedParameterDescriptor
+: public ParameterDescriptor
+{
+    static_assert( is_number_v<T>, 
+        "TypedParameterDescriptor: T must be an integer or floating point type" );
+public:
+    static ParameterDescriptorPtr Create(
+	    const std::string& name,
+	    const std::string& description = "",
+	    bool requirement = Mandatory,
+	    Constraints constraints = {});
+    TypedParameterDescriptor(
+        const std::string&,
+        const std::string&,
+        bool,
+        Constraints );
+    Diagnostic tryValidate(std::string_view, Value&) const override;
+};
+
 //-----------------------------------------------------------------------------
 
 class OptionDescriptor 
@@ -139,7 +203,15 @@ public:
         const std::string&,
         const ParameterDescriptors& );
     const ParameterDescriptors& getParameters() const;
+    // The interned name
+    Symbol getSymbol() const;
     bool validate(const Argument&, const Arguments&) const;
+    bool validate(std::string_view, const CommandLineView::Parameters&) const;
+    bool validate(std::string_view, const CommandLineView::Parameters&, Value*) const;
+private:
+    Symbol symbol;
+
+    template <class ARGUMENTS> bool validateOption(std::string_view, const ARGUMENTS&, Value*) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -163,10 +235,31 @@ public:
         const OptionDescriptors& );
     
     const OptionDescriptors& getOptions() const;
+    // nullptr, if the command has no option with that name
+    const OptionDescriptor* findOption(std::string_view) const;
+    const OptionDescriptor* findOption(Symbol) const;
+    // The interned name
+    Symbol getSymbol() const;
     
     bool validate( const CommandLine& ) const;
+    bool validate( const CommandLineView& ) const;
+    // Also stores the typed values of the arguments in the view
+    bool validate( CommandLineView& ) const;
+
+    // Same, but return the diagnostic instead of throwing an exception.
+    // A command line for another command yields ErrorCode::InvalidCommand.
+    Diagnostic tryValidate( const CommandLine& ) const;
+    Diagnostic tryValidate( const CommandLineView& ) const;
+    Diagnostic tryValidate( CommandLineView& ) const;
 private:
-    OptionDescriptors       options;
+    using OptionIndex = std::vector<std::pair<Symbol,const OptionDescriptor*>>;
+
+    Symbol                              symbol;
+    OptionDescriptors                   options;
+    OptionIndex                         option_index; // sorted by symbol
+
+    template <class COMMANDLINE> bool validateCommandLine(COMMANDLINE&) const;
+    template <class COMMANDLINE> Diagnostic tryValidateCommandLine(COMMANDLINE&) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -178,10 +271,21 @@ public:
     static DescriptorMapPtr Create(const std::string& = "Commands");
     DescriptorMap(const std::string& = "Commands");
     void attach(CommandDescriptorPtr);
+    // Attaches all or (if a name is in use already) none of the descriptors
+    void attach(const CommandDescriptors&);
+    void reserve(std::size_t);
     bool validate(const CommandLine&) const;
+    bool validate(const CommandLineView&) const;
+    bool validate(CommandLineView&) const;
     const std::vector<CommandDescriptorPtr>& getCommandDescriptors() const;
+    // nullptr, if there is no descriptor with that name
+    const CommandDescriptor* find(std::string_view) const;
+    const CommandDescriptor* find(Symbol) const;
 private:
-    std::vector<CommandDescriptorPtr> descriptors;
+    std::vector<CommandDescriptorPtr>     descriptors;
+    SymbolMap<const CommandDescriptor*> index;
+
+    template <class COMMANDLINE> bool validateCommandLine(COMMANDLINE&) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -191,6 +295,12 @@ class Constraint
 public:
     virtual ~Constraint() {}
     virtual bool validate(const std::string&) const = 0;
+    // Called while validating. Defaults to validate(std::string), so 
+    // constraints, that override that one only, are still used.
+    virtual bool validate(std::string_view) const;
+    // Called for typed parameters. Defaults to validate(text).
+    virtual bool validate(std::string_view, const Value&) const;
+    bool validate(const char* s) const { return validate( std::string_view(s) ); }
 };
 
 template <class T, int N=0> // N = number of expected arguments, 0 = any
@@ -248,7 +358,16 @@ public:
     using AcceptArgsOfSameType<T,1>::AcceptArgsOfSameType;
     bool validate(const std::string& s) const 
     {
-        return (convert<T>(s) >= this->values.at(0));
+        return validate(std::string_view(s));
+    }
+    bool validate(std::string_view s) const 
+    {
+        return validate(s, Value{});
+    }
+    bool validate(std::string_view s, const Value& v) const 
+    {
+        T x;
+        return convert(s,v,x) && x >= this->values.at(0);
     }
 };
 
@@ -261,7 +380,16 @@ public:
     using AcceptArgsOfSameType<T,1>::AcceptArgsOfSameType;
     bool validate(const std::string& s) const 
     {
-        return (convert<T>(s) <= this->values.at(0));
+        return validate(std::string_view(s));
+    }
+    bool validate(std::string_view s) const 
+    {
+        return validate(s, Value{});
+    }
+    bool validate(std::string_view s, const Value& v) const 
+    {
+        T x;
+        return convert(s,v,x) && x <= this->values.at(0);
     }
 };
 
@@ -274,7 +402,17 @@ public:
     using AcceptArgsOfSameType<T>::AcceptArgsOfSameType;
     bool validate(const std::string& s) const 
     {
-        T arg{ convert<T>(s) };
+        return validate(std::string_view(s));
+    }
+    bool validate(std::string_view s) const 
+    {
+        return validate(s, Value{});
+    }
+    bool validate(std::string_view s, const Value& v) const 
+    {
+        T arg;
+        if ( !convert(s,v,arg) )
+            return false;
         for( auto& value : this->values )
             if ( arg == value )
                 return false;
@@ -292,7 +430,17 @@ public:
     using AcceptArgsOfSameType<T,2>::AcceptArgsOfSameType;
     bool validate(const std::string& s) const 
     {
-        T x = convert<T>(s);
+        return validate(std::string_view(s));
+    }
+    bool validate(std::string_view s) const 
+    {
+        return validate(s, Value{});
+    }
+    bool validate(std::string_view s, const Value& v) const 
+    {
+        T x;
+        if ( !convert(s,v,x) )
+            return false;
         const T& t1 = this->values.at(0);
         const T& t2 = this->values.at(1);
         return ( x >= t1 && x <= t2 );
@@ -308,7 +456,17 @@ public:
     using AcceptArgsOfSameType<T>::AcceptArgsOfSameType;
     bool validate(const std::string& s) const 
     {
-        T x = convert<T>(s);
+        return validate(std::string_view(s));
+    }
+    bool validate(std::string_view s) const 
+    {
+        return validate(s, Value{});
+    }
+    bool validate(std::string_view s, const Value& v) const 
+    {
+        T x;
+        if ( !convert(s,v,x) )
+            return false;
         for( auto& t : this->values ) 
             if ( x == t ) 
                 return true;
@@ -316,6 +474,47 @@ public:
     }
 };
 
+template <class T>
+ParameterDescriptorPtr TypedParameterDescriptor<T>::Create(
+    const std::string& name,
+    const std::string& description,
+    bool required,
+    Constraints constraints )
+{
+    return std::make_shared<TypedParameterDescriptor<T>>(
+        name, description, required, constraints );
+}
+
+template <class T>
+TypedParameterDescriptor<T>::TypedParameterDescriptor(
+    const std::string& name,
+    const std::string& description,
+    bool required,
+    Constraints constraints )
+: ParameterDescriptor(
+    name, 
+    description, 
+    required, 
+    [](std::string_view s){ T t; return parseNumber(s,t); },
+    constraints )
+{
+}
+
+template <class T>
+Diagnostic TypedParameterDescriptor<T>::tryValidate(std::string_view arg, Value& value) const
+{
+    T t;
+    if ( !parseNumber(arg,t) )
+        return Diagnostic( ErrorCode::InvalidParameterType, arg );
+    value = static_cast<value_type_t<T>>(t);
+    for( auto& constraint : getConstraints() )
+    {
+        if ( !constraint->validate(arg,value) )
+            return Diagnostic( ErrorCode::InvalidParameterValue, arg );
+    }
+    return Diagnostic();
+}
+
 template <class T> 
 ConstraintPtr AtLeast(T&& t) 
 {
@@ -0,0 +1,80 @@
+#ifndef ELRAT_CLP_DIAGNOSTIC_HPP
+#define ELRAT_CLP_DIAGNOSTIC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <string_view>
+
+namespace elrat {
+namespace clp {
+
+enum class ErrorCode : std::uint8_t
+{
+    None,
+    // Parser
+    EmptyInput,
+    InvalidCommandName,
+    UnexpectedToken,
+    RedundantOptionInPack,
+    RedundantOption,
+    // Validation
+    InvalidCommand,
+    CommandNotFound,        // there is a descriptor, but no command
+    InvalidOption,
+    MissingParameters,
+    TooManyParameters,
+    InvalidParameterType,
+    InvalidParameterValue,
+    // Reported by the exception of a parser, that doesn't provide diagnostics
+    Exception
+};
+
+// Tells why an input has been rejected. The message is only formatted on
+// request, and it is the same as the one of the exception raise() throws.
+// The token refers to the input, unless detach() has been called.
+class Diagnostic
+{
+public:
+    Diagnostic() = default;
+    Diagnostic(
+        ErrorCode,
+        std::string_view token = {},
+        int actual = 0,
+        int expected = 0 );
+    // Wraps the exception, that is currently being handled
+    static Diagnostic FromCurrentException();
+
+    bool ok() const;
+    ErrorCode getCode() const;
+    std::string_view getToken() const;
+    void setToken(std::string_view);
+    // Position of the token in the input (npos, if unknown)
+    std::size_t getOffset() const;
+    // Determines the offset, if the token refers to the input
+    void locate(std::string_view input);
+    // Number of parameters found and expected (MissingParameters and
+    // TooManyParameters only)
+    int getActual() const;
+    int getExpected() const;
+
+    std::string getMessage() const;
+    [[noreturn]] void raise() const;
+    // Creates the exception now, so the diagnostic no longer refers to the input
+    void detach();
+private:
+    ErrorCode          code{ErrorCode::None};
+    std::string_view   token;
+    std::size_t        offset{std::string_view::npos};
+    int                actual{0};
+    int                expected{0};
+    std::exception_ptr exception;
+
+    template <class FUNCTION> auto withException(FUNCTION) const;
+};
+
+} // clp
+} // elrat
+
+#endif
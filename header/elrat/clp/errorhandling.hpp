@@ -67,6 +67,15 @@ public:
     CommandNotFoundException(const std::string& = "");
 };
 
+class FileException
+: public Exception
+{
+public:
+    FileException(
+        const std::string& subcategory = "",
+        const std::string& path = "" );
+};
+
 class InputException
 : public Exception
 {
@@ -0,0 +1,89 @@
+#ifndef ELRAT_CLP_EXECUTOR_HPP
+#define ELRAT_CLP_EXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <elrat/clp/stringmap.hpp>
+
+namespace elrat {
+namespace clp {
+
+class Executor;
+using ExecutorPtr = std::shared_ptr<Executor>;
+
+// Thread pool with a task queue per thread. Tasks posted by a task go to
+// the queue of its thread, others are distributed round robin. A thread
+// runs the tasks of its own queue in order, and steals the newest task of
+// another queue when its own is empty.
+class Executor
+{
+public:
+    using Task = std::function<void()>;
+    // A task, that calls 'done' once it has finished, which may be later,
+    // on another thread
+    using Job = std::function<void(Task done)>;
+
+    // Zero threads: one per core
+    static ExecutorPtr Create(std::size_t thread_count = 0);
+    explicit Executor(std::size_t thread_count = 0);
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    // Calls shutdown()
+    ~Executor();
+
+    std::size_t getThreadCount() const;
+
+    // The task must not throw.
+    void post(Task);
+    // Tasks with the same key run one after the other, in the order they
+    // have been posted.
+    void post(std::string_view key, Task);
+    // Same, but the next job for the key starts once this one is done.
+    void post(std::string_view key, Job);
+
+    // Runs all tasks, including those posted meanwhile, and stops the
+    // threads. Posting afterwards throws a std::logic_error. Must not be
+    // called by a task.
+    void shutdown();
+private:
+    struct Queue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;   // one per thread
+    std::vector<std::thread>            threads;
+    std::atomic<std::size_t>            next_queue{0};
+
+    std::mutex                          idle_mutex;
+    std::condition_variable             wakeup;
+    std::atomic<std::size_t>            pending{0};  // posted, but not started
+    bool                                stopping{false};
+    std::size_t                         running{0};  // threads, guarded by idle_mutex
+    bool                                closed{false};
+    std::atomic<bool>                   stopped{false};
+    std::mutex                          shutdown_mutex;
+
+    std::mutex                          strand_mutex;
+    StringMap<std::deque<Job>>          strands;     // waiting jobs by key
+
+    void run(std::size_t index);
+    bool take(std::size_t index, Task&);
+    void runStrand(const std::string& key, Job);
+    void continueStrand(const std::string& key);
+};
+
+} // clp
+} // elrat
+
+#endif
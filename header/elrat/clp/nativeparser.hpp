@@ -10,6 +10,14 @@ class NativeParser : public Parser
 {
 public:
     virtual CommandLine parse( const std::string& ) const;
+    virtual void parse( const std::string&, CommandLine& ) const;
+    virtual bool providesViews() const;
+    virtual void parse( std::string_view, CommandLineView& ) const;
+    virtual Diagnostic tryParse( std::string_view, CommandLineView& ) const;
+    // Each argument is a token, as the shell has split and unquoted them 
+    // already. Only "--option=parameter" is split at the equal sign.
+    virtual CommandLine parse( int argc, const char* const* argv ) const;
+    virtual Diagnostic tryParse( int argc, const char* const* argv, CommandLineView& ) const;
     virtual const std::string& getSyntaxDescription() const;
 private:
     static const std::string SyntaxDescription;
@@ -2,8 +2,11 @@
 #define ELRAT_CLP_PARSER_HPP
 
 #include <string>
+#include <string_view>
 
 #include <elrat/clp/commandline.hpp>
+#include <elrat/clp/commandlineview.hpp>
+#include <elrat/clp/diagnostic.hpp>
 
 namespace elrat {
 namespace clp {
@@ -13,6 +16,26 @@ class Parser
 public:
     virtual ~Parser();
     virtual CommandLine parse( const std::string& ) const = 0;
+    // Same into the caller's command line, which keeps its capacity, so a
+    // command line reused for similar lines doesn't allocate. By default,
+    // the returned command line is assigned.
+    virtual void parse( const std::string&, CommandLine& ) const;
+
+    // Parsers that return 'true' from providesViews() can parse into a
+    // CommandLineView that refers to the input, without copying the tokens.
+    virtual bool providesViews() const;
+    virtual void parse( std::string_view, CommandLineView& ) const;
+    // Same, but returns the diagnostic instead of throwing an exception.
+    // By default, the InputException thrown by parse() is wrapped.
+    virtual Diagnostic tryParse( std::string_view, CommandLineView& ) const;
+
+    // Parses the arguments of main(); pass argc - 1 and argv + 1 to leave
+    // out the program name. By default, the arguments are joined with 
+    // spaces, those containing whitespace quoted, and parsed as a line.
+    virtual CommandLine parse( int argc, const char* const* argv ) const;
+    // Same into a view, that refers to the arguments. Parsers, that
+    // provide views, implement it.
+    virtual Diagnostic tryParse( int argc, const char* const* argv, CommandLineView& ) const;
     virtual const std::string& getSyntaxDescription() const = 0;
 };
    
@@ -14,6 +14,7 @@ class ParserWrapper : public Parser
 public:
     using ParsingFunction = std::function<CommandLine(const std::string&)>;
     ParserWrapper( ParsingFunction, const std::string& description );
+    using Parser::parse;
     virtual CommandLine parse(const std::string&) const;
     virtual const std::string& getSyntaxDescription() const;
 private:
@@ -3,44 +3,253 @@
 
 #include <elrat/clp/commandmap.hpp>
 #include <elrat/clp/descriptors.hpp>
+#include <elrat/clp/asynccommand.hpp>
+#include <elrat/clp/diagnostic.hpp>
+#include <elrat/clp/executor.hpp>
 #include <elrat/clp/errorhandling.hpp>
 #include <elrat/clp/parser.hpp>
 #include <elrat/clp/nativeparser.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 std::ostream& operator<<(std::ostream&,const elrat::clp::CommandLine&);
 
 namespace elrat {
 namespace clp {
 
+    // Result of processing a single line of a batch
+    enum class LineStatus : std::uint8_t
+    {
+        Processed,          // validated and executed
+        InvalidSyntax,      // rejected by the parser
+        InvalidCommand,     // no descriptor or no command for the name
+        InvalidArguments,   // rejected by the descriptor
+        CommandFailed       // a command threw an exception
+    };
+
+    // Order, in which submitted lines are processed
+    enum class Ordering : std::uint8_t
+    {
+        None,               // any
+        PerCommand          // lines for the same command in order of submission
+    };
+
+    // What runFile() does with a line, that is rejected or whose command fails
+    enum class ErrorPolicy : std::uint8_t
+    {
+        Stop,               // stops at the line
+        Continue            // counts it and goes on
+    };
+
+    // Summary of runFile()
+    struct RunStats
+    {
+        std::size_t lines{0};       // read, including blank ones
+        std::size_t blank{0};       // skipped, as they are empty or whitespace
+        std::size_t processed{0};
+        std::size_t rejected{0};    // by the parser or the descriptor
+        std::size_t failed{0};      // a command threw an exception
+        std::size_t bytes{0};       // size of the file
+        double      seconds{0};
+        bool        stopped{false}; // at an error, by ErrorPolicy::Stop
+        // The first error: its line number (0, if there was none), the line,
+        // and its diagnostic, whose offset refers to the line.
+        std::size_t error_line{0};
+        std::string error_input;
+        Diagnostic  error;
+    };
+
+    template <class FUNCTION>
+    concept CommandFunction = 
+        std::is_invocable_v<FUNCTION&, const CommandLine&> ||
+        std::is_invocable_v<FUNCTION&, const CommandLineView&>;
+
+    // process(), tryProcess() and processBatch() may be called concurrently,
+    // also while other threads (or the commands) attach and detach. They 
+    // read an immutable snapshot of the descriptors and commands, without 
+    // locking. Changes become visible to the next call. The commands have 
+    // to be thread-safe themselves.
     class Processor
     {
     public:
         Processor( std::shared_ptr<Parser> = std::make_shared<NativeParser>() );
+        // The built-in help command refers to the processor
+        Processor(const Processor&) = delete;
+        Processor& operator=(const Processor&) = delete;
+        ~Processor();
 
         void attach(CommandDescriptorPtr);
+        void attach(const CommandDescriptors&);
         void attach(CommandDescriptorPtr, CommandPtr);
-        void attach(CommandDescriptorPtr, std::function<void(const CommandLine&)>);
-
         void attach(const std::string&, CommandPtr);
-        void attach(const std::string&, std::function<void(const CommandLine&)>);
+
+        // Attaches a function taking a const CommandLine& or a const 
+        // CommandLineView&. A function that accepts both (e.g. a generic
+        // lambda) gets the CommandLine.
+        template <class FUNCTION> requires CommandFunction<FUNCTION>
+        void attach(CommandDescriptorPtr, FUNCTION);
+        template <class FUNCTION> requires CommandFunction<FUNCTION>
+        void attach(const std::string&, FUNCTION);
+
+        // Attaches a coroutine (see AsyncCommand)
+        using AsyncFunction = std::function<AsyncTask(CommandLine)>;
+        void attachAsync(CommandDescriptorPtr, AsyncFunction);
+        void attachAsync(const std::string&, AsyncFunction);
+
+        // Detaches the command (all commands, if null) from the name. The
+        // descriptor remains attached.
+        void detach(const std::string&, CommandPtr = nullptr);
     
         void process(const std::string&) const;
+
+        // Same as process(), but returns the diagnostic of an invalid input
+        // instead of throwing an exception. Its token refers to the input,
+        // unless the parser doesn't provide views. Exceptions of the 
+        // commands are passed on.
+        Diagnostic tryProcess(std::string_view) const;
+
+        // Same, but the command line is allocated from the resource (e.g. a
+        // std::pmr::monotonic_buffer_resource of a request), instead of 
+        // reusing the buffers of the thread. Nothing refers to the resource
+        // after the call, except what the commands keep.
+        void process(const std::string&, std::pmr::memory_resource*) const;
+        Diagnostic tryProcess(std::string_view, std::pmr::memory_resource*) const;
+
+        // Same for the arguments of main(), which are parsed without joining
+        // them (see Parser::parse(int, const char* const*)). The tokens of the
+        // diagnostic refer to the arguments.
+        void process(int argc, const char* const* argv) const;
+        Diagnostic tryProcess(int argc, const char* const* argv) const;
+
+        // Processes each line like process(), but reports errors in the 
+        // returned status array (one per line) instead of throwing. Any 
+        // exception of a command, std::exception or not, makes its line
+        // CommandFailed, and the batch goes on. The
+        // parse buffers are reused, and consecutive lines for the same 
+        // command share the lookup of the command. The whole batch is 
+        // processed with the same snapshot.
+        std::vector<LineStatus> processBatch(std::span<const std::string_view>) const;
+
+        // Same as processBatch(), but parsing, validation and execution run
+        // as a pipeline: one thread parses, another one validates, and the
+        // calling thread executes the commands, in the order of the lines.
+        // Small batches, and parsers that don't provide views, are left to
+        // processBatch().
+        std::vector<LineStatus> processPipelined(std::span<const std::string_view>) const;
+
+        // Processes a script, one command per line, without copying it: the
+        // file is mapped into memory and parsed in place. Lines may end with
+        // "\n" or "\r\n"; blank ones are skipped. Exceptions of the commands
+        // (of any type) count as failures. Throws a FileException, if the 
+        // file can't be read.
+        RunStats runFile(const std::string& path, ErrorPolicy = ErrorPolicy::Stop) const;
+
+        // Processes the line on the executor. The future holds what 
+        // tryProcess() returns (detached from the line), or the exception 
+        // of a command. AsyncCommands don't block the executor's thread
+        // while they are suspended; the future is ready once they have 
+        // finished. For Ordering::PerCommand, the line is parsed once more
+        // by the caller, to find out its command, and the next line for
+        // the command is processed once this one is finished.
+        std::future<Diagnostic> submit(std::string, Ordering = Ordering::None);
+        // Same, but calls the completion on the executor's thread. The
+        // exception is null, unless a command threw one.
+        using Completion = std::function<void(const Diagnostic&, std::exception_ptr)>;
+        void submit(std::string, Completion, Ordering = Ordering::None);
+        // Waits until all submitted lines have been processed. Must not be 
+        // called by a command. The destructor drains as well.
+        void drain() const;
+
+        // The executor, that runs submitted lines. If none has been set, one
+        // with a thread per core is created by the first submit(). Replaced
+        // executors are kept until the processor is destroyed, as suspended
+        // commands continue on them.
+        void setExecutor(ExecutorPtr);
+        ExecutorPtr getExecutor() const;
         
     private:
         
+        struct Snapshot;
+        struct State;
+
         std::shared_ptr<Parser> parser;
-        std::vector<DescriptorMapPtr> descriptor_maps;
-        CommandMap commands;
+        std::unique_ptr<State>  state;
 
         void addExitCommand();
         void addHelpCommand();
 
+        static CommandPtr wrap(std::function<void(const CommandLine&)>);
+        static CommandPtr wrap(std::function<void(const CommandLineView&)>);
+
+        // Calls the function with the current snapshot
+        template <class FUNCTION> auto read(FUNCTION) const;
+        // Calls the function with the writers' copy of the snapshot
+        template <class FUNCTION> void update(FUNCTION);
+        void publish() const;
+
+        // tryProcess(), that passes the snapshot, the entry and the command
+        // line of a valid input to the function, instead of invoking it
+        template <class FUNCTION>
+        Diagnostic tryProcessWith(std::string_view, FUNCTION) const;
+        // Parses the input into the command line and runs it
+        template <class FUNCTION>
+        Diagnostic tryProcessIn(std::string_view, CommandLineView&, FUNCTION) const;
+        template <class FUNCTION>
+        Diagnostic tryProcessIn(std::string_view, CommandLine&, FUNCTION) const;
+        // Validates the command line and passes it to the function
+        template <class COMMANDLINE, class FUNCTION>
+        Diagnostic tryRun(COMMANDLINE&, FUNCTION) const;
+        // Processes a submitted line; calls the completion once it's done
+        void processSubmitted(const std::string&, Executor&, Completion) const;
+        template <class COMMANDLINE> 
+        Diagnostic tryValidate(const CommandMap::Entry*, COMMANDLINE&) const;
+        template <class COMMANDLINE> 
+        LineStatus dispatchLine(
+            const Snapshot&, const CommandMap::Entry*, COMMANDLINE&) const;
+        // Processed, if the command may be invoked
+        template <class COMMANDLINE> 
+        LineStatus validateLine(const CommandMap::Entry*, COMMANDLINE&) const;
+        template <class COMMANDLINE> 
+        LineStatus invokeLine(
+            const Snapshot&, const CommandMap::Entry&, COMMANDLINE&) const;
+
     };
 
+    template <class FUNCTION> requires CommandFunction<FUNCTION>
+    void Processor::attach(CommandDescriptorPtr desc, FUNCTION function)
+    {
+        if constexpr( std::is_invocable_v<FUNCTION&, const CommandLine&> )
+            attach( desc, wrap( std::function<void(const CommandLine&)>( std::move(function) ) ) );
+        else
+            attach( desc, wrap( std::function<void(const CommandLineView&)>( std::move(function) ) ) );
+    }
+
+    template <class FUNCTION> requires CommandFunction<FUNCTION>
+    void Processor::attach(const std::string& name, FUNCTION function)
+    {
+        if constexpr( std::is_invocable_v<FUNCTION&, const CommandLine&> )
+            attach( name, wrap( std::function<void(const CommandLine&)>( std::move(function) ) ) );
+        else
+            attach( name, wrap( std::function<void(const CommandLineView&)>( std::move(function) ) ) );
+    }
+
 } // clp
 } // elrat
 
+std::ostream& operator<<(std::ostream&,const elrat::clp::RunStats&);
+
 #endif
 
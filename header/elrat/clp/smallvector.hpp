@@ -0,0 +1,186 @@
+#ifndef ELRAT_CLP_SMALLVECTOR_HPP
+#define ELRAT_CLP_SMALLVECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace elrat {
+namespace clp {
+
+// Vector of trivially copyable elements, that keeps up to N of them inside
+// the object. Only when it grows beyond N, it allocates, from its memory
+// resource. Like the std::pmr containers, a copy uses the default resource,
+// and moving between different resources copies the elements.
+template <class T, std::size_t N>
+class SmallVector
+{
+    static_assert( std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T> );
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+    explicit SmallVector(std::pmr::memory_resource*);
+    SmallVector(const SmallVector&);
+    SmallVector(SmallVector&&) noexcept;
+    SmallVector& operator=(const SmallVector&);
+    SmallVector& operator=(SmallVector&&);
+    ~SmallVector();
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t capacity() const { return heap ? heap_capacity : N; }
+    std::pmr::memory_resource* resource() const { return memory; }
+
+    T* data() { return heap ? heap : local; }
+    const T* data() const { return heap ? heap : local; }
+    iterator begin() { return data(); }
+    iterator end() { return data() + count; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + count; }
+
+    T& operator[](std::size_t i) { return data()[i]; }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+    T& back() { return data()[count - 1]; }
+    const T& back() const { return data()[count - 1]; }
+
+    void push_back(const T&);
+    // Appends n elements
+    void append(const T*, std::size_t n);
+    void reserve(std::size_t);
+    // Keeps the capacity
+    void clear() { count = 0; }
+private:
+    T                          local[N];
+    T*                         heap{ nullptr };
+    std::size_t                heap_capacity{0};
+    std::size_t                count{0};
+    std::pmr::memory_resource* memory{ std::pmr::get_default_resource() };
+
+    void grow(std::size_t minimum);
+    void release();
+};
+
+template <class T, std::size_t N>
+SmallVector<T,N>::SmallVector(std::pmr::memory_resource* resource)
+: memory{ resource }
+{
+}
+
+template <class T, std::size_t N>
+SmallVector<T,N>::SmallVector(const SmallVector& other)
+{
+    append( other.data(), other.size() );
+}
+
+template <class T, std::size_t N>
+SmallVector<T,N>::SmallVector(SmallVector&& other) noexcept
+: memory{ other.memory }
+{
+    *this = std::move(other);
+}
+
+template <class T, std::size_t N>
+SmallVector<T,N>::~SmallVector()
+{
+    release();
+}
+
+template <class T, std::size_t N>
+SmallVector<T,N>& SmallVector<T,N>::operator=(const SmallVector& other)
+{
+    if ( this != &other )
+    {
+        clear();
+        append( other.data(), other.size() );
+    }
+    return *this;
+}
+
+// Takes over the other's allocation, if it has one from the same resource.
+// Only a copy between different resources may throw.
+template <class T, std::size_t N>
+SmallVector<T,N>& SmallVector<T,N>::operator=(SmallVector&& other)
+{
+    if ( this == &other )
+        return *this;
+    if ( other.heap && *memory == *other.memory )
+    {
+        release();
+        heap = std::exchange( other.heap, nullptr );
+        heap_capacity = std::exchange( other.heap_capacity, 0 );
+        count = std::exchange( other.count, 0 );
+        return *this;
+    }
+    clear();
+    append( other.data(), other.size() );
+    other.clear();
+    return *this;
+}
+
+// The value may be an element of the vector itself
+template <class T, std::size_t N>
+void SmallVector<T,N>::push_back(const T& value)
+{
+    const T copy{ value };
+    if ( count == capacity() )
+        grow( count + 1 );
+    data()[count++] = copy;
+}
+
+// The values may be elements of the vector itself
+template <class T, std::size_t N>
+void SmallVector<T,N>::append(const T* values, std::size_t n)
+{
+    if ( count + n > capacity() )
+    {
+        const std::less<const T*> before;
+        const bool own{ !before( values, data() ) && before( values, data() + count ) };
+        const std::size_t offset( own ? values - data() : 0 );
+        grow( count + n );
+        if ( own )
+            values = data() + offset;
+    }
+    if ( n )
+        std::memcpy( data() + count, values, n * sizeof(T) );
+    count += n;
+}
+
+template <class T, std::size_t N>
+void SmallVector<T,N>::reserve(std::size_t n)
+{
+    if ( n > capacity() )
+        grow( n );
+}
+
+template <class T, std::size_t N>
+void SmallVector<T,N>::grow(std::size_t minimum)
+{
+    const std::size_t new_capacity{ std::max( minimum, 2 * capacity() ) };
+    auto grown{ static_cast<T*>( memory->allocate( new_capacity * sizeof(T), alignof(T) ) ) };
+    if ( count )
+        std::memcpy( grown, data(), count * sizeof(T) );
+    release();
+    heap = grown;
+    heap_capacity = new_capacity;
+}
+
+template <class T, std::size_t N>
+void SmallVector<T,N>::release()
+{
+    if ( heap )
+        memory->deallocate( heap, heap_capacity * sizeof(T), alignof(T) );
+    heap = nullptr;
+    heap_capacity = 0;
+}
+
+} // clp
+} // elrat
+
+#endif
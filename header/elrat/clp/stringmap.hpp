@@ -0,0 +1,228 @@
+#ifndef ELRAT_CLP_STRINGMAP_HPP
+#define ELRAT_CLP_STRINGMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace elrat {
+namespace clp {
+
+// Hash map from strings to T, that is looked up by std::string_view.
+// The entries are stored densely in a vector, in order of insertion. The
+// hash table (open addressing with linear probing) only holds indices into
+// that vector. Erasing moves the last entry into the gap.
+// Inserting and erasing invalidate pointers to the values.
+template <class T>
+class StringMap
+{
+public:
+    struct Entry
+    {
+        std::string key;
+        T value;
+        std::size_t hash;
+    };
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+    T* find(std::string_view);
+    const T* find(std::string_view) const;
+    bool contains(std::string_view) const;
+
+    // Returns the value of the key and whether it was inserted. The value
+    // of a key, that exists already, is not changed. If an exception is
+    // thrown, the map remains unchanged.
+    std::pair<T*,bool> insert(std::string_view key, T value);
+    bool erase(std::string_view);
+
+    void reserve(std::size_t);
+    void clear();
+    std::size_t size() const;
+    bool empty() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+private:
+    static constexpr std::uint32_t Empty{0}; // otherwise: index of the entry + 1
+    static constexpr std::size_t MinimumSlotCount{8};
+
+    std::vector<Entry>         entries;
+    std::vector<std::uint32_t> slots; // size is zero or a power of two
+
+    static std::size_t hashOf(std::string_view);
+    std::size_t mask() const;
+    // The slot, that holds the key, or the empty slot ending its probe sequence
+    std::size_t findSlot(std::string_view, std::size_t hash) const;
+    void reserveSlots(std::size_t count);
+    void rehash(std::size_t slot_count);
+};
+
+template <class T>
+T* StringMap<T>::find(std::string_view key)
+{
+    return const_cast<T*>( static_cast<const StringMap&>(*this).find(key) );
+}
+
+template <class T>
+const T* StringMap<T>::find(std::string_view key) const
+{
+    if ( slots.empty() )
+        return nullptr;
+    const auto slot{ slots[ findSlot(key, hashOf(key)) ] };
+    return ( slot == Empty ) ? nullptr : &entries[slot - 1].value;
+}
+
+template <class T>
+bool StringMap<T>::contains(std::string_view key) const
+{
+    return find(key) != nullptr;
+}
+
+template <class T>
+std::pair<T*,bool> StringMap<T>::insert(std::string_view key, T value)
+{
+    reserveSlots( entries.size() + 1 );
+    const auto hash{ hashOf(key) };
+    const auto slot{ findSlot(key, hash) };
+    if ( slots[slot] != Empty )
+        return { &entries[slots[slot] - 1].value, false };
+    entries.push_back( Entry{ std::string(key), std::move(value), hash } );
+    slots[slot] = static_cast<std::uint32_t>( entries.size() );
+    return { &entries.back().value, true };
+}
+
+template <class T>
+bool StringMap<T>::erase(std::string_view key)
+{
+    if ( slots.empty() )
+        return false;
+    auto slot{ findSlot(key, hashOf(key)) };
+    if ( slots[slot] == Empty )
+        return false;
+    const std::size_t index{ slots[slot] - 1u };
+
+    // Close the gap in the probe sequence (backward shift deletion)
+    slots[slot] = Empty;
+    for( auto next{ (slot + 1) & mask() }; slots[next] != Empty; next = (next + 1) & mask() )
+    {
+        const auto home{ entries[slots[next] - 1].hash & mask() };
+        if ( ((next - home) & mask()) >= ((next - slot) & mask()) )
+        {
+            slots[slot] = slots[next];
+            slots[next] = Empty;
+            slot = next;
+        }
+    }
+
+    // Keep the entries dense
+    const std::size_t last{ entries.size() - 1 };
+    if ( index != last )
+    {
+        auto moved{ entries[last].hash & mask() };
+        while( slots[moved] != last + 1 )
+            moved = (moved + 1) & mask();
+        slots[moved] = static_cast<std::uint32_t>( index + 1 );
+        entries[index] = std::move( entries[last] );
+    }
+    entries.pop_back();
+    return true;
+}
+
+template <class T>
+void StringMap<T>::reserve(std::size_t count)
+{
+    reserveSlots( count );
+    entries.reserve( count );
+}
+
+template <class T>
+void StringMap<T>::clear()
+{
+    entries.clear();
+    std::fill( slots.begin(), slots.end(), Empty );
+}
+
+template <class T>
+std::size_t StringMap<T>::size() const
+{
+    return entries.size();
+}
+
+template <class T>
+bool StringMap<T>::empty() const
+{
+    return entries.empty();
+}
+
+template <class T>
+typename StringMap<T>::const_iterator StringMap<T>::begin() const
+{
+    return entries.begin();
+}
+
+template <class T>
+typename StringMap<T>::const_iterator StringMap<T>::end() const
+{
+    return entries.end();
+}
+
+template <class T>
+std::size_t StringMap<T>::hashOf(std::string_view key)
+{
+    return std::hash<std::string_view>{}(key);
+}
+
+template <class T>
+std::size_t StringMap<T>::mask() const
+{
+    return slots.size() - 1;
+}
+
+template <class T>
+std::size_t StringMap<T>::findSlot(std::string_view key, std::size_t hash) const
+{
+    auto slot{ hash & mask() };
+    while( slots[slot] != Empty )
+    {
+        const auto& entry{ entries[slots[slot] - 1] };
+        if ( entry.hash == hash && entry.key == key )
+            break;
+        slot = (slot + 1) & mask();
+    }
+    return slot;
+}
+
+template <class T>
+void StringMap<T>::reserveSlots(std::size_t count)
+{
+    // A load factor of at most 1/2 keeps the probe sequences short.
+    std::size_t slot_count{ slots.empty() ? MinimumSlotCount : slots.size() };
+    while( slot_count < 2 * count )
+        slot_count *= 2;
+    if ( slot_count != slots.size() )
+        rehash( slot_count );
+}
+
+template <class T>
+void StringMap<T>::rehash(std::size_t slot_count)
+{
+    std::vector<std::uint32_t> rehashed( slot_count, Empty );
+    for( std::size_t i{0}; i < entries.size(); i++ )
+    {
+        auto slot{ entries[i].hash & (slot_count - 1) };
+        while( rehashed[slot] != Empty )
+            slot = (slot + 1) & (slot_count - 1);
+        rehashed[slot] = static_cast<std::uint32_t>( i + 1 );
+    }
+    slots.swap( rehashed );
+}
+
+} // clp
+} // elrat
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef ELRAT_CLP_SYMBOLMAP_HPP
+#define ELRAT_CLP_SYMBOLMAP_HPP
+
+#include <elrat/clp/symbols.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace elrat {
+namespace clp {
+
+// Hash map from symbols to T, laid out like StringMap: the entries are
+// stored densely, in order of insertion, and the hash table (open
+// addressing with linear probing) holds indices into them. Its size
+// depends on the number of entries only, not on the number of symbols in
+// the process, so copying a map costs the same, however many names have
+// been interned elsewhere. Erasing moves the last entry into the gap.
+// Inserting and erasing invalidate pointers to the values.
+template <class T>
+class SymbolMap
+{
+public:
+    struct Entry
+    {
+        Symbol key;
+        T value;
+    };
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+    T* find(Symbol);
+    const T* find(Symbol) const;
+    bool contains(Symbol) const;
+
+    // Returns the value of the key and whether it was inserted. The value
+    // of a key, that exists already, is not changed. If an exception is
+    // thrown, the map remains unchanged.
+    std::pair<T*,bool> insert(Symbol key, T value);
+    bool erase(Symbol);
+
+    void reserve(std::size_t);
+    void clear();
+    std::size_t size() const;
+    bool empty() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+private:
+    static constexpr std::uint32_t Empty{0}; // otherwise: index of the entry + 1
+    static constexpr std::size_t MinimumSlotCount{8};
+
+    std::vector<Entry>         entries;
+    std::vector<std::uint32_t> slots; // size is zero or a power of two
+
+    // Symbols are consecutive; multiplying spreads them over the table
+    static std::size_t hashOf(Symbol);
+    std::size_t mask() const;
+    // The slot, that holds the key, or the empty slot ending its probe sequence
+    std::size_t findSlot(Symbol) const;
+    void reserveSlots(std::size_t count);
+    void rehash(std::size_t slot_count);
+};
+
+template <class T>
+T* SymbolMap<T>::find(Symbol key)
+{
+    return const_cast<T*>( static_cast<const SymbolMap&>(*this).find(key) );
+}
+
+template <class T>
+const T* SymbolMap<T>::find(Symbol key) const
+{
+    if ( slots.empty() )
+        return nullptr;
+    const auto slot{ slots[ findSlot(key) ] };
+    return ( slot == Empty ) ? nullptr : &entries[slot - 1].value;
+}
+
+template <class T>
+bool SymbolMap<T>::contains(Symbol key) const
+{
+    return find(key) != nullptr;
+}
+
+template <class T>
+std::pair<T*,bool> SymbolMap<T>::insert(Symbol key, T value)
+{
+    reserveSlots( entries.size() + 1 );
+    const auto slot{ findSlot(key) };
+    if ( slots[slot] != Empty )
+        return { &entries[slots[slot] - 1].value, false };
+    entries.push_back( Entry{ key, std::move(value) } );
+    slots[slot] = static_cast<std::uint32_t>( entries.size() );
+    return { &entries.back().value, true };
+}
+
+template <class T>
+bool SymbolMap<T>::erase(Symbol key)
+{
+    if ( slots.empty() )
+        return false;
+    auto slot{ findSlot(key) };
+    if ( slots[slot] == Empty )
+        return false;
+    const std::size_t index{ slots[slot] - 1u };
+
+    // Close the gap in the probe sequence (backward shift deletion)
+    slots[slot] = Empty;
+    for( auto next{ (slot + 1) & mask() }; slots[next] != Empty; next = (next + 1) & mask() )
+    {
+        const auto home{ hashOf( entries[slots[next] - 1].key ) & mask() };
+        if ( ((next - home) & mask()) >= ((next - slot) & mask()) )
+        {
+            slots[slot] = slots[next];
+            slots[next] = Empty;
+            slot = next;
+        }
+    }
+
+    // Keep the entries dense
+    const std::size_t last{ entries.size() - 1 };
+    if ( index != last )
+    {
+        auto moved{ hashOf( entries[last].key ) & mask() };
+        while( slots[moved] != last + 1 )
+            moved = (moved + 1) & mask();
+        slots[moved] = static_cast<std::uint32_t>( index + 1 );
+        entries[index] = std::move( entries[last] );
+    }
+    entries.pop_back();
+    return true;
+}
+
+template <class T>
+void SymbolMap<T>::reserve(std::size_t count)
+{
+    reserveSlots( count );
+    entries.reserve( count );
+}
+
+template <class T>
+void SymbolMap<T>::clear()
+{
+    entries.clear();
+    std::fill( slots.begin(), slots.end(), Empty );
+}
+
+template <class T>
+std::size_t SymbolMap<T>::size() const
+{
+    return entries.size();
+}
+
+template <class T>
+bool SymbolMap<T>::empty() const
+{
+    return entries.empty();
+}
+
+template <class T>
+typename SymbolMap<T>::const_iterator SymbolMap<T>::begin() const
+{
+    return entries.begin();
+}
+
+template <class T>
+typename SymbolMap<T>::const_iterator SymbolMap<T>::end() const
+{
+    return entries.end();
+}
+
+template <class T>
+std::size_t SymbolMap<T>::hashOf(Symbol key)
+{
+    // Fibonacci hashing; the upper half has the well mixed bits
+    return static_cast<std::size_t>( ( std::uint64_t{key} * 0x9E3779B97F4A7C15ull ) >> 32 );
+}
+
+template <class T>
+std::size_t SymbolMap<T>::mask() const
+{
+    return slots.size() - 1;
+}
+
+template <class T>
+std::size_t SymbolMap<T>::findSlot(Symbol key) const
+{
+    auto slot{ hashOf(key) & mask() };
+    while( slots[slot] != Empty && entries[slots[slot] - 1].key != key )
+        slot = (slot + 1) & mask();
+    return slot;
+}
+
+template <class T>
+void SymbolMap<T>::reserveSlots(std::size_t count)
+{
+    // A load factor of at most 1/2 keeps the probe sequences short.
+    std::size_t slot_count{ slots.empty() ? MinimumSlotCount : slots.size() };
+    while( slot_count < 2 * count )
+        slot_count *= 2;
+    if ( slot_count != slots.size() )
+        rehash( slot_count );
+}
+
+template <class T>
+void SymbolMap<T>::rehash(std::size_t slot_count)
+{
+    std::vector<std::uint32_t> rehashed( slot_count, Empty );
+    for( std::size_t i{0}; i < entries.size(); i++ )
+    {
+        auto slot{ hashOf( entries[i].key ) & (slot_count - 1) };
+        while( rehashed[slot] != Empty )
+            slot = (slot + 1) & (slot_count - 1);
+        rehashed[slot] = static_cast<std::uint32_t>( i + 1 );
+    }
+    slots.swap( rehashed );
+}
+
+} // clp
+} // elrat
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef ELRAT_CLP_SYMBOLS_HPP
+#define ELRAT_CLP_SYMBOLS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace elrat {
+namespace clp {
+
+// Small integer, that stands for the name of a command or an option. The
+// names are interned, when descriptors are created; equal names have equal
+// symbols throughout the process.
+using Symbol = std::uint32_t;
+
+// Symbol of a name, that hasn't been interned
+constexpr Symbol NoSymbol{0};
+
+// Process-wide table of interned names. Interning locks, looking up
+// neither locks nor allocates, so parsers resolve every name they read.
+// Names are never removed.
+class Symbols
+{
+public:
+    // Returns the symbol of the name, which is added, if it's new
+    static Symbol intern(std::string_view);
+    // NoSymbol, if the name hasn't been interned
+    static Symbol find(std::string_view);
+    // Empty for NoSymbol; throws std::out_of_range for unknown symbols
+    static std::string_view getName(Symbol);
+    static std::size_t size();
+};
+
+// Compares the symbols of two names, if both have one, the texts otherwise
+// (a name may have been resolved before it was interned).
+inline bool sameName(Symbol a, std::string_view a_text, Symbol b, std::string_view b_text)
+{
+    if ( a != NoSymbol && b != NoSymbol )
+        return a == b;
+    return a_text == b_text;
+}
+
+} // clp
+} // elrat
+
+#endif
@@ -1,27 +1,45 @@
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 
 #include "elrat/clp/commandline.hpp"
+#include "elrat/clp/commandlineview.hpp"
 
 using namespace elrat::clp;
 using Parameters = CommandLine::Parameters;
+using TextRange = CommandLine::TextRange;
+
+CommandLine::CommandLine(std::pmr::memory_resource* resource)
+: text{resource}
+, parameters{resource}
+, options{resource}
+, option_parameters{resource}
+{
+}
+
+CommandLine::CommandLine(const CommandLineView& view)
+{
+    assign( view );
+}
+
+std::pmr::memory_resource* CommandLine::getMemoryResource() const
+{
+    return text.resource();
+}
 
 CommandLine::operator bool() const 
 {
-    return ( command.size() > 0 );
+    return ( command.size > 0 );
 }
 
-const std::string& CommandLine::getCommand() const 
+std::string CommandLine::getCommand() const 
 {
-    return command;
+    return std::string( getCommandText() );
 }
 
-bool CommandLine::optionExists(const std::string& option_name) const
+bool CommandLine::optionExists(std::string_view option_name) const
 {
-    for( auto opt : options )
-        if ( opt.first == option_name )
-            return true;
-    return false;
+    return findOption( option_name ) >= 0;
 }
 
 int CommandLine::getOptionCount() const 
@@ -29,63 +47,230 @@ int CommandLine::getOptionCount() const
     return options.size();
 }
 
-const std::string& CommandLine::getOption(int index) const 
+std::string CommandLine::getOption(int index) const 
+{
+    return std::string( getOptionText(index) );
+}
+
+Symbol CommandLine::getCommandSymbol() const
+{
+    return command_symbol;
+}
+
+Symbol CommandLine::getOptionSymbol(int index) const
+{
+    if ( index < 0 || index >= getOptionCount() )
+        throw std::out_of_range("getOptionSymbol: Invalid index.");
+    return options[index].symbol;
+}
+
+int CommandLine::getOptionIndex(Symbol symbol) const
+{
+    if ( symbol == NoSymbol )
+        return -1;
+    for( std::size_t i{0}; i < options.size(); i++ )
+        if ( options[i].symbol == symbol )
+            return i;
+    return -1;
+}
+
+Parameters CommandLine::getCommandParameters() const 
+{
+    const auto texts{ getCommandParameterTexts() };
+    return Parameters( texts.begin(), texts.end() );
+}
+
+std::string CommandLine::getCommandParameter(int index) const
+{
+    return std::string( getCommandParameterText(index) );
+}
+
+Parameters CommandLine::getOptionParameters(std::string_view option_name ) const
+{
+    const auto texts{ getOptionParameterTexts(option_name) };
+    return Parameters( texts.begin(), texts.end() );
+}
+
+Parameters CommandLine::getOptionParameters(int index) const 
 {
-    return options.at(index).first;
+    const auto texts{ getOptionParameterTexts(index) };
+    return Parameters( texts.begin(), texts.end() );
 }
 
-const Parameters& CommandLine::getCommandParameters() const 
+std::string_view CommandLine::getCommandText() const 
 {
-    return parameters;
+    return tokenText( command );
 }
 
-const std::string& CommandLine::getCommandParameter(int index) const
+std::string_view CommandLine::getOptionText(int index) const 
 {
-    return parameters.at(index);
+    if ( index < 0 || index >= getOptionCount() )
+        throw std::out_of_range("getOption: Invalid index.");
+    return tokenText( options[index].name );
 }
 
-const Parameters& CommandLine::getOptionParameters(const std::string& option_name ) const
+std::string_view CommandLine::getCommandParameterText(int index) const
 {
-    for( auto& opt: options )
-        if (opt.first == option_name)
-            return opt.second;
-    throw std::invalid_argument("getOptionParameter: Option not found.");
+    return getCommandParameterTexts().at(index);
 }
 
-const Parameters& CommandLine::getOptionParameters(int index) const 
+TextRange CommandLine::getCommandParameterTexts() const 
 {
-    return options.at(index).second;
+    return TextRange( text.data(), parameters.data(), parameters.size() );
 }
 
+TextRange CommandLine::getOptionParameterTexts(std::string_view option_name ) const
+{
+    const int index{ findOption( option_name ) };
+    if ( index < 0 )
+        throw std::invalid_argument("getOptionParameter: Option not found.");
+    return getOptionParameterTexts( index );
+}
+
+TextRange CommandLine::getOptionParameterTexts(int index) const 
+{
+    if ( index < 0 || index >= getOptionCount() )
+        throw std::out_of_range("getOptionParameters: Invalid index.");
+    const auto& option{ options[index] };
+    return TextRange( 
+        text.data(), option_parameters.data() + option.first_parameter, option.parameter_count );
+}
 
-void CommandLine::setCommand(const std::string& command_name)
+void CommandLine::setCommand(std::string_view command_name)
 {
-    command = command_name;
+    setCommand( command_name, Symbols::find(command_name) );
 }
 
-void CommandLine::addCommandParameter(const std::string& parameter)
+void CommandLine::setCommand(std::string_view command_name, Symbol symbol)
 {
-    parameters.push_back(parameter);
+    command = store( command_name );
+    command_symbol = symbol;
 }
 
-void CommandLine::addOption(const std::string& option_name)
+void CommandLine::addCommandParameter(std::string_view parameter)
 {
-    options.push_back( std::make_pair(option_name, Parameters{}) );
+    parameters.push_back( store(parameter) );
 }
 
-void CommandLine::addOptionParameter(const std::string& parameter)
+void CommandLine::addOption(std::string_view option_name)
+{
+    addOption( option_name, Symbols::find(option_name) );
+}
+
+void CommandLine::addOption(std::string_view option_name, Symbol symbol)
+{
+    const Option option{ 
+        store(option_name), symbol, static_cast<std::uint32_t>( option_parameters.size() ), 0 };
+    options.push_back( option );
+}
+
+void CommandLine::addOptionParameter(std::string_view parameter)
 {
     if (!options.size())
         throw std::runtime_error("addOptionParameter: No option added yet.");
-    options.back().second.push_back(parameter);
+    // The parameters of the last option are the last ones
+    option_parameters.push_back( store(parameter) );
+    options.back().parameter_count++;
+}
+
+void CommandLine::clear()
+{
+    text.clear();
+    command = Token{0,0};
+    command_symbol = NoSymbol;
+    parameters.clear();
+    options.clear();
+    option_parameters.clear();
+}
+
+void CommandLine::assign(const CommandLineView& view)
+{
+    // The symbols have been resolved already
+    clear();
+    setCommand( view.getCommand(), view.getCommandSymbol() );
+    for( auto parameter : view.getCommandParameters() )
+        addCommandParameter( parameter );
+    for( int i{0}; i < view.getOptionCount(); i++ )
+    {
+        addOption( view.getOption(i), view.getOptionSymbol(i) );
+        for( auto parameter : view.getOptionParameters(i) )
+            addOptionParameter( parameter );
+    }
+}
+
+// The text may be a token of this command line, which append() copes with
+CommandLine::Token CommandLine::store(std::string_view token)
+{
+    if ( text.size() + token.size() > std::numeric_limits<std::uint32_t>::max() )
+        throw std::length_error("CommandLine: Tokens too long.");
+    const Token stored{ 
+        static_cast<std::uint32_t>( text.size() ), 
+        static_cast<std::uint32_t>( token.size() ) };
+    text.append( token.data(), token.size() );
+    return stored;
+}
+
+std::string_view CommandLine::tokenText(Token token) const
+{
+    return { text.data() + token.begin, token.size };
+}
+
+int CommandLine::findOption(std::string_view option_name) const
+{
+    const auto symbol{ Symbols::find(option_name) };
+    for( std::size_t i{0}; i < options.size(); i++ )
+        if ( sameName( options[i].symbol, tokenText( options[i].name ), symbol, option_name ) )
+            return i;
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+TextRange::TextRange(const char* t, const Token* f, std::size_t c)
+: text{t}
+, first{f}
+, count{c}
+{
+}
+
+TextRange::const_iterator TextRange::begin() const
+{
+    return const_iterator( text, first );
+}
+
+TextRange::const_iterator TextRange::end() const
+{
+    return const_iterator( text, first + count );
+}
+
+std::size_t TextRange::size() const
+{
+    return count;
+}
+
+bool TextRange::empty() const
+{
+    return count == 0;
+}
+
+std::string_view TextRange::operator[](std::size_t i) const
+{
+    return { text + first[i].begin, first[i].size };
+}
+
+std::string_view TextRange::at(std::size_t i) const
+{
+    if ( i >= count )
+        throw std::out_of_range("TextRange::at(): Invalid index.");
+    return (*this)[i];
 }
 
 std::ostream& operator<<(std::ostream& os, const elrat::clp::CommandLine& cl)
 {
-    static auto print_parameters{
-        [&os](bool indent, const std::vector<std::string>& vec)
+    const auto print_parameters{
+        [&os](bool indent, const TextRange& vec)
         {
-            for( int i{0}; i < vec.size(); i++ )
+            for( std::size_t i{0}; i < vec.size(); i++ )
             {
                 if (indent)
                     os << "  ";
@@ -96,22 +281,22 @@ std::ostream& operator<<(std::ostream& os, const elrat::clp::CommandLine& cl)
             }
         }
     };
-    if (!cl.getCommand().size()) 
+    if (!cl.getCommandText().size()) 
         return os;
     
     os << "Command............: \""
-        << cl.getCommand()
+        << cl.getCommandText()
         << "\"\n";
-    print_parameters( false, cl.getCommandParameters() );
+    print_parameters( false, cl.getCommandParameterTexts() );
     
     int count = cl.getOptionCount();
     for( int i{0}; i < count; i++ )
     {        
         os << "-> Option" 
             << "..........: \""
-            << cl.getOption(i)
+            << cl.getOptionText(i)
             << "\"\n";
-        print_parameters(true, cl.getOptionParameters(i));
+        print_parameters(true, cl.getOptionParameterTexts(i));
     }
     return os;
 }
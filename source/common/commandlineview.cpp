@@ -0,0 +1,261 @@
+#include <stdexcept>
+
+#include "elrat/clp/commandline.hpp"
+#include "elrat/clp/commandlineview.hpp"
+
+using namespace elrat::clp;
+using Parameters = CommandLineView::Parameters;
+
+CommandLineView::CommandLineView(std::pmr::memory_resource* resource)
+: parameters{resource}
+, options{resource}
+, option_parameters{resource}
+, parameter_values{resource}
+, option_parameter_values{resource}
+{
+}
+
+// The symbols have been resolved already
+CommandLineView::CommandLineView(const CommandLine& cmdline)
+: command{cmdline.getCommandText()}
+, command_symbol{cmdline.getCommandSymbol()}
+{
+    for( auto parameter : cmdline.getCommandParameterTexts() )
+        addCommandParameter(parameter);
+    for( int i{0}; i < cmdline.getOptionCount(); i++ )
+    {
+        addOption( cmdline.getOptionText(i), cmdline.getOptionSymbol(i) );
+        for( auto parameter : cmdline.getOptionParameterTexts(i) )
+            addOptionParameter(parameter);
+    }
+}
+
+std::pmr::memory_resource* CommandLineView::getMemoryResource() const
+{
+    return parameters.get_allocator().resource();
+}
+
+CommandLineView::operator bool() const
+{
+    return ( command.size() > 0 );
+}
+
+std::string_view CommandLineView::getCommand() const
+{
+    return command;
+}
+
+bool CommandLineView::optionExists(std::string_view option_name) const
+{
+    return findOption(option_name) >= 0;
+}
+
+int CommandLineView::getOptionCount() const
+{
+    return options.size();
+}
+
+std::string_view CommandLineView::getOption(int index) const
+{
+    return options.at(index).name;
+}
+
+Parameters CommandLineView::getCommandParameters() const
+{
+    return Parameters( parameters.data(), parameters.size() );
+}
+
+std::string_view CommandLineView::getCommandParameter(int index) const
+{
+    return parameters.at(index);
+}
+
+Parameters CommandLineView::getOptionParameters(std::string_view option_name) const
+{
+    int index{ findOption(option_name) };
+    if ( index < 0 )
+        throw std::invalid_argument("getOptionParameter: Option not found.");
+    return getOptionParameters(index);
+}
+
+Parameters CommandLineView::getOptionParameters(int index) const
+{
+    auto& option{ options.at(index) };
+    return Parameters(
+        option_parameters.data() + option.first_parameter,
+        option.parameter_count );
+}
+
+std::string_view CommandLineView::getCommandText() const
+{
+    return getCommand();
+}
+
+std::string_view CommandLineView::getOptionText(int index) const
+{
+    return getOption(index);
+}
+
+std::string_view CommandLineView::getCommandParameterText(int index) const
+{
+    return getCommandParameter(index);
+}
+
+Parameters CommandLineView::getCommandParameterTexts() const
+{
+    return getCommandParameters();
+}
+
+Parameters CommandLineView::getOptionParameterTexts(std::string_view option_name) const
+{
+    return getOptionParameters(option_name);
+}
+
+Parameters CommandLineView::getOptionParameterTexts(int index) const
+{
+    return getOptionParameters(index);
+}
+
+const Value& CommandLineView::getCommandParameterValue(int index) const
+{
+    return parameter_values.at(index);
+}
+
+const Value& CommandLineView::getOptionParameterValue(int opt_index, int param_index) const
+{
+    auto& option{ options.at(opt_index) };
+    if ( param_index < 0 || static_cast<std::size_t>( param_index ) >= option.parameter_count )
+        throw std::out_of_range("CommandLineView::getOptionParameterValue()");
+    return option_parameter_values[option.first_parameter + param_index];
+}
+
+Value* CommandLineView::getCommandParameterValues()
+{
+    return parameter_values.data();
+}
+
+Value* CommandLineView::getOptionParameterValues(int index)
+{
+    return option_parameter_values.data() + options.at(index).first_parameter;
+}
+
+const OptionDescriptor* CommandLineView::getOptionDescriptor(int index) const
+{
+    return options.at(index).descriptor;
+}
+
+void CommandLineView::setOptionDescriptor(int index, const OptionDescriptor* descriptor)
+{
+    options.at(index).descriptor = descriptor;
+}
+
+void CommandLineView::setCommand(std::string_view command_name)
+{
+    command = command_name;
+    command_symbol = Symbols::find( command_name );
+}
+
+void CommandLineView::addCommandParameter(std::string_view parameter)
+{
+    parameters.push_back(parameter);
+    parameter_values.emplace_back();
+}
+
+void CommandLineView::addOption(std::string_view option_name)
+{
+    addOption( option_name, Symbols::find(option_name) );
+}
+
+void CommandLineView::addOption(std::string_view option_name, Symbol symbol)
+{
+    options.push_back( Option{option_name, symbol, option_parameters.size(), 0, nullptr} );
+}
+
+void CommandLineView::addOptionParameter(std::string_view parameter)
+{
+    if (!options.size())
+        throw std::runtime_error("addOptionParameter: No option added yet.");
+    option_parameters.push_back(parameter);
+    option_parameter_values.emplace_back();
+    options.back().parameter_count++;
+}
+
+void CommandLineView::clear()
+{
+    command = std::string_view{};
+    command_symbol = NoSymbol;
+    parameters.clear();
+    options.clear();
+    option_parameters.clear();
+    parameter_values.clear();
+    option_parameter_values.clear();
+}
+
+int CommandLineView::findOption(std::string_view option_name) const
+{
+    const auto symbol{ Symbols::find(option_name) };
+    for( int i{0}; i < static_cast<int>( options.size() ); i++ )
+        if ( sameName( options[i].symbol, options[i].name, symbol, option_name ) )
+            return i;
+    return -1;
+}
+
+Symbol CommandLineView::getCommandSymbol() const
+{
+    return command_symbol;
+}
+
+Symbol CommandLineView::getOptionSymbol(int index) const
+{
+    return options.at(index).symbol;
+}
+
+int CommandLineView::getOptionIndex(Symbol symbol) const
+{
+    if ( symbol == NoSymbol )
+        return -1;
+    for( int i{0}; i < static_cast<int>( options.size() ); i++ )
+        if ( options[i].symbol == symbol )
+            return i;
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+Parameters::Parameters(const std::string_view* p, std::size_t n)
+: first{p}
+, count{n}
+{
+}
+
+Parameters::const_iterator Parameters::begin() const
+{
+    return first;
+}
+
+Parameters::const_iterator Parameters::end() const
+{
+    return first + count;
+}
+
+std::size_t Parameters::size() const
+{
+    return count;
+}
+
+bool Parameters::empty() const
+{
+    return count == 0;
+}
+
+std::string_view Parameters::operator[](std::size_t index) const
+{
+    return first[index];
+}
+
+std::string_view Parameters::at(std::size_t index) const
+{
+    if ( index >= count )
+        throw std::out_of_range("CommandLineView::Parameters::at()");
+    return first[index];
+}
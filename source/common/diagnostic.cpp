@@ -0,0 +1,150 @@
+#include <functional>
+#include <stdexcept>
+
+#include "elrat/clp/diagnostic.hpp"
+#include "elrat/clp/errorhandling.hpp"
+
+using namespace elrat::clp;
+
+Diagnostic::Diagnostic(
+    ErrorCode error_code,
+    std::string_view error_token,
+    int actual_count,
+    int expected_count )
+: code{error_code}
+, token{error_token}
+, actual{actual_count}
+, expected{expected_count}
+{
+}
+
+// Calls the function with the exception, that corresponds to the error.
+template <class FUNCTION>
+auto Diagnostic::withException(FUNCTION function) const
+{
+    if ( exception )
+    {
+        try
+        {
+            std::rethrow_exception( exception );
+        }
+        catch( const Exception& e )
+        {
+            return function(e);
+        }
+        catch( const std::exception& e )
+        {
+            return function(e);
+        }
+    }
+
+    const std::string argument(token);
+    switch( code )
+    {
+        case ErrorCode::EmptyInput:
+            return function( InputException("NativeParser::parse()", "Received empty string") );
+        case ErrorCode::InvalidCommandName:
+            return function( InputException(argument, " is not an Identifier-Plus") );
+        case ErrorCode::UnexpectedToken:
+            return function( InputException(argument, " not allowed in this context.") );
+        case ErrorCode::RedundantOptionInPack:
+            return function( InputException(argument, "contains option that already exists.") );
+        case ErrorCode::RedundantOption:
+            return function( InputException(argument, "Already exists") );
+        case ErrorCode::InvalidCommand:
+            return function( InvalidCommandException(argument) );
+        case ErrorCode::CommandNotFound:
+            return function( CommandNotFoundException(argument) );
+        case ErrorCode::InvalidOption:
+            return function( InvalidOptionException(argument) );
+        case ErrorCode::MissingParameters:
+            return function( MissingParametersException(expected - actual) );
+        case ErrorCode::TooManyParameters:
+            return function( TooManyParametersException(actual, expected) );
+        case ErrorCode::InvalidParameterType:
+            return function( InvalidParameterTypeException(argument) );
+        case ErrorCode::InvalidParameterValue:
+            return function( InvalidParameterValueException(argument) );
+        default:
+            return function( std::logic_error("Diagnostic: No error") );
+    }
+}
+
+Diagnostic Diagnostic::FromCurrentException()
+{
+    Diagnostic diagnostic( ErrorCode::Exception );
+    diagnostic.exception = std::current_exception();
+    return diagnostic;
+}
+
+bool Diagnostic::ok() const
+{
+    return code == ErrorCode::None;
+}
+
+ErrorCode Diagnostic::getCode() const
+{
+    return code;
+}
+
+std::string_view Diagnostic::getToken() const
+{
+    return token;
+}
+
+void Diagnostic::setToken(std::string_view error_token)
+{
+    token = error_token;
+}
+
+std::size_t Diagnostic::getOffset() const
+{
+    return offset;
+}
+
+void Diagnostic::locate(std::string_view input)
+{
+    const auto begin{ input.data() };
+    const auto end{ begin + input.size() };
+    // The token may point into another object, and only the comparison
+    // objects order unrelated pointers
+    if ( std::greater_equal<>{}( token.data(), begin ) 
+      && std::less_equal<>{}( token.data() + token.size(), end ) )
+        offset = token.data() - begin;
+}
+
+int Diagnostic::getActual() const
+{
+    return actual;
+}
+
+int Diagnostic::getExpected() const
+{
+    return expected;
+}
+
+std::string Diagnostic::getMessage() const
+{
+    return withException( [](const std::exception& e) {
+        return std::string( e.what() );
+    });
+}
+
+void Diagnostic::raise() const
+{
+    if ( exception )
+        std::rethrow_exception( exception );
+    withException( [](const auto& e) {
+        throw e;
+    });
+    throw std::logic_error("Diagnostic::raise(): No error");
+}
+
+void Diagnostic::detach()
+{
+    if ( !exception && !ok() )
+        exception = withException( [](const auto& e) {
+            return std::make_exception_ptr(e);
+        });
+    token = std::string_view{};
+}
@@ -0,0 +1,92 @@
+#include "common/epoch.hpp"
+
+// All operations on the epoch, the counters and the objects they protect
+// are sequentially consistent: a reader increments its counter, then loads
+// the object; a writer replaces the object, then checks the counters. So
+// either the writer sees the reader, or the reader sees the new object.
+
+EpochDomain::Guard::Guard(std::atomic<long>& counter)
+: readers{&counter}
+{
+}
+
+EpochDomain::Guard::Guard(Guard&& other)
+: readers{other.readers}
+{
+    other.readers = nullptr;
+}
+
+EpochDomain::Guard::~Guard()
+{
+    if ( readers )
+        readers->fetch_sub(1);
+}
+
+EpochDomain::~EpochDomain()
+{
+    for( auto& deleters : retired )
+        for( auto& deleter : deleters )
+            deleter();
+}
+
+EpochDomain::Guard EpochDomain::pin()
+{
+    auto& slot{ slots[ slotOfThisThread() ] };
+    auto& readers{ slot.readers[ epoch.load() & 1 ] };
+    readers.fetch_add(1);
+    return Guard( readers );
+}
+
+void EpochDomain::retire(std::function<void()> deleter)
+{
+    std::vector<std::function<void()>> deletable;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        retired[ epoch.load() & 1 ].push_back( std::move(deleter) );
+        deletable = advance();
+    }
+    // Outside the lock, as the deleted objects may retire others
+    for( auto& d : deletable )
+        d();
+}
+
+std::size_t EpochDomain::reclaim()
+{
+    std::vector<std::function<void()>> deletable;
+    std::size_t waiting;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // The objects retired in the current epoch need two advances.
+        deletable = advance();
+        for( auto& d : advance() )
+            deletable.push_back( std::move(d) );
+        waiting = retired[0].size() + retired[1].size();
+    }
+    for( auto& d : deletable )
+        d();
+    return waiting;
+}
+
+std::size_t EpochDomain::slotOfThisThread()
+{
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t slot{ next++ % SlotCount };
+    return slot;
+}
+
+// Readers of the current epoch e use parity e & 1, stragglers of e - 1 the
+// other one. Once there are none of them, nobody can use what was retired
+// during e - 1 anymore (it was replaced before the epoch became e), and
+// their parity can be reused for e + 1.
+std::vector<std::function<void()>> EpochDomain::advance()
+{
+    const auto current{ epoch.load() };
+    const auto previous{ (current + 1) & 1 };
+    for( auto& slot : slots )
+        if ( slot.readers[previous].load() != 0 )
+            return {};
+    std::vector<std::function<void()>> deletable;
+    deletable.swap( retired[previous] );
+    epoch.store( current + 1 );
+    return deletable;
+}
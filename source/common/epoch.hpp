@@ -0,0 +1,74 @@
+#ifndef COMMON_EPOCH_HPP
+#define COMMON_EPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Epoch based reclamation of objects, that readers may still use after a
+// writer has replaced them. Readers pin the domain while they use such an
+// object. Writers retire the replaced object, which is deleted once every
+// reader, that might have seen it, has unpinned the domain.
+//
+// Pinning neither locks nor allocates: it increments a counter of the
+// current epoch's parity, in a cache line shared by few threads. The epoch
+// advances when no reader is left in the previous one; everything retired
+// before that is deleted then.
+class EpochDomain
+{
+    struct Slot;
+public:
+    class Guard
+    {
+    public:
+        Guard(Guard&&);
+        Guard(const Guard&)=delete;
+        Guard& operator=(const Guard&)=delete;
+        Guard& operator=(Guard&&)=delete;
+        ~Guard();
+    private:
+        friend class EpochDomain;
+        explicit Guard(std::atomic<long>&);
+        std::atomic<long>* readers;
+    };
+
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&)=delete;
+    EpochDomain& operator=(const EpochDomain&)=delete;
+    // Deletes everything retired. No reader may be pinned anymore.
+    ~EpochDomain();
+
+    Guard pin();
+    // The deleter is called once no reader can use the object anymore
+    void retire(std::function<void()> deleter);
+    template <class T> void retire(const T*);
+    // Deletes what can be deleted now and returns the number of objects,
+    // that are still waiting.
+    std::size_t reclaim();
+private:
+    static constexpr std::size_t SlotCount{64};
+    struct alignas(64) Slot
+    {
+        std::atomic<long> readers[2]{}; // per epoch parity
+    };
+
+    Slot                               slots[SlotCount];
+    std::atomic<std::uint64_t>         epoch{0};
+    std::mutex                         mutex;        // serializes writers
+    std::vector<std::function<void()>> retired[2];   // per epoch parity
+
+    static std::size_t slotOfThisThread();
+    // Returns the objects, that can be deleted now (mutex held)
+    std::vector<std::function<void()>> advance();
+};
+
+template <class T>
+void EpochDomain::retire(const T* object)
+{
+    retire( [object]{ delete object; } );
+}
+
+#endif
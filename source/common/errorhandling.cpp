@@ -63,6 +63,13 @@ clp::CommandNotFoundException::CommandNotFoundException(
 }
 
 
+clp::FileException::FileException(
+    const std::string& subcategory,
+    const std::string& path )
+: Exception("FileException",subcategory,path)
+{
+}
+
 clp::InputException::InputException(
     const std::string& subcategory,
     const std::string& arg )
@@ -0,0 +1,190 @@
+#ifndef COMMON_LEXICAL_HPP
+#define COMMON_LEXICAL_HPP
+
+#include <cstddef>
+#include <string_view>
+
+// Character classes as understood by the library's regular expressions
+// (ECMAScript grammar, "C" locale).
+namespace lexical
+{
+    constexpr bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    constexpr bool isAlpha(char c)
+    {
+        return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' );
+    }
+
+    // \w
+    constexpr bool isWordCharacter(char c)
+    {
+        return isAlpha(c) || isDigit(c) || c == '_';
+    }
+
+    constexpr bool isHexDigit(char c)
+    {
+        return isDigit(c) || ( c >= 'a' && c <= 'f' ) || ( c >= 'A' && c <= 'F' );
+    }
+
+    // \s
+    constexpr bool isWhitespace(char c)
+    {
+        return c == ' ' || ( c >= '\t' && c <= '\r' );
+    }
+
+    // Returns true, if 's' is not empty and each character satisfies 'predicate'.
+    template <class PREDICATE>
+    constexpr bool consistsOf(std::string_view s, PREDICATE predicate)
+    {
+        if ( s.empty() )
+            return false;
+        for( char c : s )
+            if ( !predicate(c) )
+                return false;
+        return true;
+    }
+
+    constexpr std::string_view withoutSign(std::string_view s, bool allow_minus = true)
+    {
+        if ( !s.empty() && ( s[0] == '+' || ( allow_minus && s[0] == '-' ) ) )
+            s.remove_prefix(1);
+        return s;
+    }
+
+    // Strings over 'predicate' and 'separator', that don't contain two
+    // consecutive separators, e.g. (\\?[\w\-_\. ]+)*\\?
+    template <class PREDICATE>
+    constexpr bool isSeparatedSequence(std::string_view s, PREDICATE predicate, char separator)
+    {
+        for( std::size_t i{0}; i < s.size(); i++ )
+        {
+            if ( s[i] == separator )
+            {
+                if ( i > 0 && s[i-1] == separator )
+                    return false;
+            }
+            else if ( !predicate(s[i]) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // \w+(\.\w+)*(\-\w+)*
+    constexpr bool isDottedAndDashedWords(std::string_view s)
+    {
+        bool dash_found{false};
+        std::size_t i{0};
+        while( true )
+        {
+            const std::size_t word_begin{i};
+            while( i < s.size() && isWordCharacter(s[i]) )
+                i++;
+            if ( i == word_begin )
+                return false;
+            if ( i == s.size() )
+                return true;
+            if ( s[i] == '-' )
+                dash_found = true;
+            else if ( s[i] != '.' || dash_found )
+                return false;
+            i++;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    // Replacements for the regular expressions in common/regex.hpp, that
+    // accept the same languages.
+
+    // [\+-]?\d+
+    constexpr bool IsDecimal(std::string_view s)
+    {
+        return consistsOf( withoutSign(s), isDigit );
+    }
+
+    // \+?\d+
+    constexpr bool IsPositiveDecimal(std::string_view s)
+    {
+        return consistsOf( withoutSign(s, false), isDigit );
+    }
+
+    // 0[xX][0-9a-fA-F]+
+    constexpr bool IsHexaDecimal(std::string_view s)
+    {
+        return s.size() > 2 
+            && s[0] == '0' 
+            && ( s[1] == 'x' || s[1] == 'X' )
+            && consistsOf( s.substr(2), isHexDigit );
+    }
+
+    // [\+-]?\d*\.?\d+
+    constexpr bool IsFloatingPoint(std::string_view s)
+    {
+        s = withoutSign(s);
+        const auto dot{ s.find('.') };
+        if ( dot == std::string_view::npos )
+            return consistsOf( s, isDigit );
+        return ( dot == 0 || consistsOf( s.substr(0, dot), isDigit ) )
+            && consistsOf( s.substr(dot + 1), isDigit );
+    }
+
+    // [_a-zA-Z]+[\w-]*\w+
+    constexpr bool IsName(std::string_view s)
+    {
+        return s.size() > 1
+            && ( isAlpha(s[0]) || s[0] == '_' )
+            && isWordCharacter(s.back())
+            && consistsOf( s, [](char c){ return isWordCharacter(c) || c == '-'; } );
+    }
+
+    // [_a-zA-Z]\w+
+    constexpr bool IsIdentifier(std::string_view s)
+    {
+        return s.size() > 1
+            && ( isAlpha(s[0]) || s[0] == '_' )
+            && consistsOf( s, isWordCharacter );
+    }
+
+    // ([a-zA-Z]:(\\[\w\-_\. ])?)?(\\?[\w\-_\. ]+)*\\?
+    constexpr bool IsWindowsPath(std::string_view s)
+    {
+        constexpr auto isPathCharacter{ [](char c) {
+            return isWordCharacter(c) || c == '-' || c == '.' || c == ' ';
+        }};
+        if ( s.size() > 1 && isAlpha(s[0]) && s[1] == ':' )
+            s.remove_prefix(2);
+        return isSeparatedSequence( s, isPathCharacter, '\\' );
+    }
+
+    // (/?[\w\-_(\.\.?) ]+)*/?
+    constexpr bool IsUnixPath(std::string_view s)
+    {
+        constexpr auto isPathCharacter{ [](char c) {
+            return isWordCharacter(c) 
+                || c == '-' || c == '.' || c == ' '
+                || c == '(' || c == ')' || c == '?';
+        }};
+        return isSeparatedSequence( s, isPathCharacter, '/' );
+    }
+
+    // \w+(\.\w+)*(\-\w+)*@\w+(\.\w+)*(\-\w+)*\.\w+
+    constexpr bool IsEmailAddress(std::string_view s)
+    {
+        const auto at{ s.find('@') };
+        if ( at == std::string_view::npos )
+            return false;
+        const auto domain{ s.substr(at + 1) };
+        const auto dot{ domain.rfind('.') };
+        if ( dot == std::string_view::npos )
+            return false;
+        return isDottedAndDashedWords( s.substr(0, at) )
+            && isDottedAndDashedWords( domain.substr(0, dot) )
+            && consistsOf( domain.substr(dot + 1), isWordCharacter );
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef COMMON_LOCALPOOL_HPP
+#define COMMON_LOCALPOOL_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Objects of type T, that each thread keeps for reuse. A lease takes one
+// from the calling thread's pool (or creates it) and puts it back when it
+// ends, with whatever capacity it has grown. Leases may nest, e.g. when a
+// command processes another line: each one gets an object of its own.
+//
+// The objects are handed out as they have been left; the user resets them.
+// The pool holds as many objects as leases have been nested on the thread,
+// and releases them when the thread ends.
+template <class T>
+class LocalPool
+{
+public:
+    class Lease
+    {
+    public:
+        Lease() : object{ LocalPool::take() } {}
+        Lease(const Lease&)=delete;
+        Lease& operator=(const Lease&)=delete;
+        ~Lease() { LocalPool::give( std::move(object) ); }
+
+        T& operator*() const { return *object; }
+        T* operator->() const { return object.get(); }
+    private:
+        std::unique_ptr<T> object;
+    };
+private:
+    static std::vector<std::unique_ptr<T>>& objects()
+    {
+        thread_local std::vector<std::unique_ptr<T>> free_objects;
+        return free_objects;
+    }
+
+    static std::unique_ptr<T> take()
+    {
+        auto& free_objects{ objects() };
+        if ( free_objects.empty() )
+            return std::make_unique<T>();
+        auto object{ std::move( free_objects.back() ) };
+        free_objects.pop_back();
+        return object;
+    }
+
+    // Dropped, if the pool can't take it back
+    static void give(std::unique_ptr<T> object) noexcept
+    {
+        try
+        {
+            objects().push_back( std::move(object) );
+        }
+        catch(...)
+        {
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "common/mappedfile.hpp"
+#include "elrat/clp/errorhandling.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Closes the descriptor, which the mapping doesn't need
+    struct Descriptor
+    {
+        int fd;
+        ~Descriptor() { ::close(fd); }
+    };
+
+    [[noreturn]] void fail(const std::string& what, const std::string& path)
+    {
+        elrat::clp::FileException exception( what, path );
+        exception.append( std::string(" ") + std::strerror(errno) );
+        throw exception;
+    }
+}
+
+MappedFile::MappedFile(const std::string& path)
+{
+    const int fd{ ::open( path.c_str(), O_RDONLY | O_CLOEXEC ) };
+    if ( fd < 0 )
+        fail( "Cannot open", path );
+    Descriptor descriptor{ fd };
+    struct stat status;
+    if ( ::fstat( fd, &status ) != 0 )
+        fail( "Cannot stat", path );
+    size = static_cast<std::size_t>( status.st_size );
+    // An empty file can't be mapped, but there's nothing to read anyway.
+    if ( size == 0 )
+        return;
+    data = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    if ( data == MAP_FAILED )
+    {
+        data = nullptr;
+        fail( "Cannot map", path );
+    }
+    // Scripts are read once, from the beginning to the end.
+    ::madvise( data, size, MADV_SEQUENTIAL );
+}
+
+MappedFile::~MappedFile()
+{
+    if ( data )
+        ::munmap( data, size );
+}
+
+std::string_view MappedFile::getContents() const
+{
+    return { static_cast<const char*>(data), data ? size : 0 };
+}
@@ -0,0 +1,25 @@
+#ifndef COMMON_MAPPEDFILE_HPP
+#define COMMON_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// A file mapped into memory for reading. The contents are valid as long as
+// the object exists. Throws a FileException, if the file can't be opened
+// or mapped.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&)=delete;
+    MappedFile& operator=(const MappedFile&)=delete;
+    ~MappedFile();
+
+    std::string_view getContents() const;
+private:
+    void*       data{ nullptr };
+    std::size_t size{ 0 };
+};
+
+#endif
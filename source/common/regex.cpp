@@ -6,9 +6,9 @@ RegEx::RegEx(const std::string& regular_expression)
 {
 }
 
-bool RegEx::operator()(const std::string& candidate) const
+bool RegEx::operator()(std::string_view candidate) const
 {
-    return std::regex_match( candidate, this->regex );
+    return std::regex_match( candidate.begin(), candidate.end(), this->regex );
 }
 
 const RegEx IsDecimal(
@@ -3,12 +3,13 @@
 
 #include <regex>
 #include <string>
+#include <string_view>
 
 class RegEx
 {
 public:
     RegEx(const std::string& regular_expression);
-    bool operator()(const std::string& candidate) const;
+    bool operator()(std::string_view candidate) const;
 private:
     std::regex regex;
 };
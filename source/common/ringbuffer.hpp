@@ -0,0 +1,141 @@
+#ifndef COMMON_RINGBUFFER_HPP
+#define COMMON_RINGBUFFER_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Bounded queue for exactly one producer and one consumer thread, without
+// locks. tryPush() fails when the ring is full and tryPop() when it is
+// empty. pop() waits for an element: it spins for a while and then sleeps
+// until the producer pushes or the ring is closed.
+//
+// The producer owns 'tail', the consumer 'head'. Each one keeps a copy of
+// the other's index and only reloads it when the copy says full or empty,
+// so the cache lines of the indices don't bounce with every element. The
+// producer only touches 'events', if the consumer has announced to sleep.
+template <class T>
+class SpscRing
+{
+public:
+    // The capacity is rounded up to a power of two
+    explicit SpscRing(std::size_t capacity);
+    SpscRing(const SpscRing&)=delete;
+    SpscRing& operator=(const SpscRing&)=delete;
+
+    std::size_t capacity() const { return slots.size(); }
+
+    // Producer only
+    bool tryPush(const T&);
+    // Consumer only
+    bool tryPop(T&);
+    // Consumer only. False, if the ring is empty and has been closed.
+    bool pop(T&);
+    // Wakes the consumer, whose pop() fails from now on, when it's empty.
+    // Any thread may close the ring.
+    void close();
+private:
+    static constexpr int                 SpinCount{ 64 };
+
+    std::vector<T>                       slots;
+    const std::size_t                    mask;
+
+    alignas(64) std::atomic<std::size_t> head{0};   // next to pop
+    std::size_t                          cached_tail{0};
+    alignas(64) std::atomic<std::size_t> tail{0};   // next to push
+    std::size_t                          cached_head{0};
+    alignas(64) std::atomic<bool>        sleeping{false};
+    std::atomic<std::uint32_t>           events{0};  // the consumer sleeps on
+    std::atomic<bool>                    closed{false};
+
+    void wake();
+};
+
+template <class T>
+SpscRing<T>::SpscRing(std::size_t capacity)
+: slots( std::bit_ceil( capacity ? capacity : 1 ) )
+, mask{ slots.size() - 1 }
+{
+}
+
+template <class T>
+bool SpscRing<T>::tryPush(const T& value)
+{
+    const auto t{ tail.load(std::memory_order_relaxed) };
+    if ( t - cached_head == slots.size() )
+    {
+        cached_head = head.load(std::memory_order_acquire);
+        if ( t - cached_head == slots.size() )
+            return false;
+    }
+    slots[ t & mask ] = value;
+    tail.store( t + 1, std::memory_order_release );
+    // Either the consumer sees the element, or this sees it sleeping
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    if ( sleeping.load(std::memory_order_relaxed) )
+        wake();
+    return true;
+}
+
+template <class T>
+bool SpscRing<T>::tryPop(T& value)
+{
+    const auto h{ head.load(std::memory_order_relaxed) };
+    if ( h == cached_tail )
+    {
+        cached_tail = tail.load(std::memory_order_acquire);
+        if ( h == cached_tail )
+            return false;
+    }
+    value = slots[ h & mask ];
+    head.store( h + 1, std::memory_order_release );
+    return true;
+}
+
+template <class T>
+bool SpscRing<T>::pop(T& value)
+{
+    for( int spin{0}; spin < SpinCount; spin++ )
+    {
+        if ( tryPop(value) )
+            return true;
+        if ( closed.load() )
+            return false;
+        std::this_thread::yield();
+    }
+    for(;;)
+    {
+        // Loaded before announcing, so a later event ends the wait
+        const auto event{ events.load() };
+        sleeping.store( true, std::memory_order_relaxed );
+        // Either this sees the element, or the producer sees it sleeping
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        const bool popped{ tryPop(value) };
+        if ( !popped && !closed.load() )
+            events.wait( event );
+        sleeping.store( false, std::memory_order_relaxed );
+        if ( popped || tryPop(value) )
+            return true;
+        if ( closed.load() )
+            return false;
+    }
+}
+
+template <class T>
+void SpscRing<T>::close()
+{
+    closed.store( true );
+    wake();
+}
+
+template <class T>
+void SpscRing<T>::wake()
+{
+    events.fetch_add( 1 );
+    events.notify_one();
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include "elrat/clp/symbols.hpp"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace elrat::clp;
+
+namespace
+{
+    struct Name
+    {
+        std::string text;
+        std::size_t hash;
+        Symbol      symbol;
+    };
+
+    // Open addressing with linear probing, at most half full, so every
+    // probe sequence ends at an empty slot. The writer only fills empty
+    // slots; readers see a slot either empty or with a complete name.
+    struct Table
+    {
+        explicit Table(std::size_t slot_count)
+        : slots{ new std::atomic<const Name*>[slot_count]{} }
+        , names{ new std::atomic<const Name*>[slot_count / 2]{} }
+        , mask{ slot_count - 1 }
+        {
+        }
+
+        std::size_t capacity() const { return ( mask + 1 ) / 2; }
+
+        // Writer only
+        void insert(const Name& name)
+        {
+            auto i{ name.hash & mask };
+            while( slots[i].load(std::memory_order_relaxed) )
+                i = ( i + 1 ) & mask;
+            names[name.symbol - 1].store( &name, std::memory_order_release );
+            slots[i].store( &name, std::memory_order_release );
+        }
+
+        Symbol find(std::string_view text, std::size_t hash) const
+        {
+            for( auto i{ hash & mask }; ; i = ( i + 1 ) & mask )
+            {
+                const Name* name{ slots[i].load(std::memory_order_acquire) };
+                if ( !name )
+                    return NoSymbol;
+                if ( name->hash == hash && name->text == text )
+                    return name->symbol;
+            }
+        }
+
+        std::unique_ptr<std::atomic<const Name*>[]> slots;
+        std::unique_ptr<std::atomic<const Name*>[]> names; // by symbol - 1
+        const std::size_t                           mask;
+    };
+
+    // A table, that has become too small, is replaced by one twice its size.
+    // The replaced ones are kept, as readers may still probe them; together
+    // they are smaller than the current one.
+    struct State
+    {
+        std::mutex                          mutex;     // serializes writers
+        std::deque<Name>                    names;     // don't move
+        std::vector<std::unique_ptr<Table>> tables;
+        std::atomic<const Table*>           published{ nullptr };
+        std::atomic<std::size_t>            count{0};
+    };
+
+    // Never destroyed, as names may be looked up during static destruction
+    State& state()
+    {
+        static State* const instance{ new State };
+        return *instance;
+    }
+
+    std::size_t hashOf(std::string_view text)
+    {
+        return std::hash<std::string_view>{}(text);
+    }
+}
+
+Symbol Symbols::intern(std::string_view text)
+{
+    auto& s{ state() };
+    const auto hash{ hashOf(text) };
+    std::lock_guard<std::mutex> lock( s.mutex );
+    // The last table is the published one
+    Table* table{ s.tables.empty() ? nullptr : s.tables.back().get() };
+    if ( table )
+    {
+        const auto symbol{ table->find( text, hash ) };
+        if ( symbol != NoSymbol )
+            return symbol;
+    }
+
+    const auto count{ s.count.load(std::memory_order_relaxed) };
+    if ( count == std::numeric_limits<Symbol>::max() )
+        throw std::length_error("Symbols::intern(): Too many names.");
+    if ( !table || count == table->capacity() )
+    {
+        auto grown{ std::make_unique<Table>( table ? 4 * table->capacity() : 64 ) };
+        for( auto& name : s.names )
+            grown->insert( name );
+        s.tables.reserve( s.tables.size() + 1 );
+        table = grown.get();
+        s.tables.push_back( std::move(grown) );
+        s.published.store( table, std::memory_order_release );
+    }
+    const Symbol symbol( count + 1 );
+    auto& name{ s.names.emplace_back( Name{ std::string(text), hash, symbol } ) };
+    table->insert( name );
+    s.count.store( symbol, std::memory_order_release );
+    return symbol;
+}
+
+Symbol Symbols::find(std::string_view text)
+{
+    const Table* table{ state().published.load(std::memory_order_acquire) };
+    return table ? table->find( text, hashOf(text) ) : NoSymbol;
+}
+
+std::string_view Symbols::getName(Symbol symbol)
+{
+    if ( symbol == NoSymbol )
+        return {};
+    auto& s{ state() };
+    if ( symbol > s.count.load(std::memory_order_acquire) )
+        throw std::out_of_range("Symbols::getName(): Unknown symbol.");
+    const Table* table{ s.published.load(std::memory_order_acquire) };
+    return table->names[symbol - 1].load(std::memory_order_acquire)->text;
+}
+
+std::size_t Symbols::size()
+{
+    return state().count.load(std::memory_order_acquire);
+}
@@ -1,6 +1,12 @@
 #include "elrat/clp/descriptors.hpp"
 #include "elrat/clp/errorhandling.hpp"
+
+#ifdef CLP_USE_REGEX
 #include "common/regex.hpp"
+#else
+#include "common/lexical.hpp"
+using namespace lexical;
+#endif
 
 using namespace elrat;
 using namespace elrat::clp;
@@ -8,42 +14,82 @@ using namespace elrat::clp;
 const bool clp::Mandatory{true};
 const bool clp::Optional{false};
 
-bool ParameterType::Any(const std::string& s)
+namespace
+{
+    // Only a mutable view keeps the typed values of the arguments.
+    Value* commandParameterValues(const CommandLine&) 
+    { 
+        return nullptr; 
+    }
+
+    Value* commandParameterValues(const CommandLineView&) 
+    { 
+        return nullptr; 
+    }
+
+    Value* commandParameterValues(CommandLineView& cmdline) 
+    { 
+        return cmdline.getCommandParameterValues(); 
+    }
+
+    // The option has been matched by name already
+    Diagnostic validateOption(const HasParameters& option, const CommandLine& cmdline, int i)
+    {
+        return option.tryValidate( cmdline.getOptionParameterTexts(i) );
+    }
+
+    Diagnostic validateOption(const HasParameters& option, const CommandLineView& cmdline, int i)
+    {
+        return option.tryValidate( cmdline.getOptionParameters(i) );
+    }
+
+    Diagnostic validateOption(const OptionDescriptor& option, CommandLineView& cmdline, int i)
+    {
+        auto diagnostic{ static_cast<const HasParameters&>(option).tryValidate(
+            cmdline.getOptionParameters(i), 
+            cmdline.getOptionParameterValues(i) ) };
+        if ( diagnostic.ok() )
+            cmdline.setOptionDescriptor( i, &option );
+        return diagnostic;
+    }
+}
+
+bool ParameterType::Any(std::string_view s)
 {
     return (s.size() > 0);
 }
 
-bool ParameterType::NaturalNumber(const std::string& s)
+bool ParameterType::NaturalNumber(std::string_view s)
 {
     return IsPositiveDecimal(s) || IsHexaDecimal(s);
 }
 
-bool ParameterType::WholeNumber(const std::string& s)
+bool ParameterType::WholeNumber(std::string_view s)
 {   
     return IsDecimal(s) || IsHexaDecimal(s);
 }
 
-bool ParameterType::RealNumber(const std::string& s)
+bool ParameterType::RealNumber(std::string_view s)
 {
     return IsFloatingPoint(s);
 }
 
-bool ParameterType::Name(const std::string& s)
+bool ParameterType::Name(std::string_view s)
 {
     return IsName(s);
 }
 
-bool ParameterType::Identifier(const std::string& s)
+bool ParameterType::Identifier(std::string_view s)
 {
     return IsIdentifier(s);
 }
 
-bool ParameterType::Path(const std::string& s)
+bool ParameterType::Path(std::string_view s)
 {
     return (IsWindowsPath(s) || IsUnixPath(s));
 }
 
-bool ParameterType::EmailAddress(const std::string& s)
+bool ParameterType::EmailAddress(std::string_view s)
 {
     return IsEmailAddress(s);
 }
@@ -115,12 +161,72 @@ int HasParameters::getRequiredParameterCount() const
 
 void HasParameters::validate(const Arguments& args) const
 {
-    if ( args.size() > parameters.size() )
-        throw TooManyParametersException( args.size(), parameters.size() );
-    if ( args.size() < numberOfRequiredParameters )
-        throw MissingParametersException(numberOfRequiredParameters - args.size());
-    for( int i{0}; i < args.size(); ++i )
-        parameters[i]->validate( args[i] );
+    validateArguments(args, nullptr);
+}
+
+void HasParameters::validate(const CommandLine::TextRange& args) const
+{
+    validateArguments(args, nullptr);
+}
+
+void HasParameters::validate(const CommandLineView::Parameters& args) const
+{
+    validateArguments(args, nullptr);
+}
+
+void HasParameters::validate(const CommandLineView::Parameters& args, Value* values) const
+{
+    validateArguments(args, values);
+}
+
+Diagnostic HasParameters::tryValidate(const Arguments& args) const
+{
+    return tryValidateArguments(args, nullptr);
+}
+
+Diagnostic HasParameters::tryValidate(const CommandLine::TextRange& args) const
+{
+    return tryValidateArguments(args, nullptr);
+}
+
+Diagnostic HasParameters::tryValidate(
+    const CommandLineView::Parameters& args, 
+    Value* values) const
+{
+    return tryValidateArguments(args, values);
+}
+
+template <class ARGUMENTS>
+void HasParameters::validateArguments(const ARGUMENTS& args, Value* values) const
+{
+    const auto diagnostic{ tryValidateArguments(args, values) };
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
+}
+
+// The first superfluous argument is the token of TooManyParameters. Missing
+// parameters have no token here; the owner of the parameters names itself.
+template <class ARGUMENTS>
+Diagnostic HasParameters::tryValidateArguments(const ARGUMENTS& args, Value* values) const
+{
+    const int count{ static_cast<int>( args.size() ) };
+    const int parameter_count{ static_cast<int>( parameters.size() ) };
+    if ( count > parameter_count )
+        return Diagnostic( 
+            ErrorCode::TooManyParameters, args[parameter_count], count, parameter_count );
+    if ( count < numberOfRequiredParameters )
+        return Diagnostic( 
+            ErrorCode::MissingParameters, {}, count, numberOfRequiredParameters );
+    for( int i{0}; i < count; ++i )
+    {
+        Value value;
+        auto diagnostic{ parameters[i]->tryValidate( args[i], value ) };
+        if ( !diagnostic.ok() )
+            return diagnostic;
+        if ( values )
+            values[i] = value;
+    }
+    return Diagnostic();
 }
 
 //-----------------------------------------------------------------------------
@@ -167,15 +273,37 @@ const Constraints& ParameterDescriptor::getConstraints() const
     return constraints;
 }
 
-void ParameterDescriptor::validate(const Argument& arg) const
+Value ParameterDescriptor::validate(std::string_view arg) const
+{
+    Value value;
+    const auto diagnostic{ tryValidate(arg, value) };
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
+    return value;
+}
+
+Diagnostic ParameterDescriptor::tryValidate(std::string_view arg, Value&) const
 {
     if ( !type_checker(arg) )
-        throw InvalidParameterTypeException(arg);
+        return Diagnostic( ErrorCode::InvalidParameterType, arg );
     for( auto& constraint : constraints )
     {
         if ( !constraint->validate(arg) )
-            throw InvalidParameterValueException(arg);
+            return Diagnostic( ErrorCode::InvalidParameterValue, arg );
     }
+    return Diagnostic();
+}
+
+//-----------------------------------------------------------------------------
+
+bool Constraint::validate(std::string_view s) const
+{
+    return validate( std::string(s) );
+}
+
+bool Constraint::validate(std::string_view s, const Value&) const
+{
+    return validate(s);
 }
 
 //-----------------------------------------------------------------------------
@@ -196,16 +324,48 @@ OptionDescriptor::OptionDescriptor(
 : HasName(name)
 , HasDescription(description)
 , HasParameters{parameter_descriptors}
+, symbol{ Symbols::intern(name) }
+{
+}
+
+Symbol OptionDescriptor::getSymbol() const
 {
+    return symbol;
 }
 
 bool OptionDescriptor::validate( const Argument& name,const Arguments& args ) const
+{
+    return validateOption( name, args, nullptr );
+}
+
+bool OptionDescriptor::validate( 
+    std::string_view name, 
+    const CommandLineView::Parameters& args ) const
+{
+    return validateOption( name, args, nullptr );
+}
+
+bool OptionDescriptor::validate( 
+    std::string_view name, 
+    const CommandLineView::Parameters& args,
+    Value* values ) const
+{
+    return validateOption( name, args, values );
+}
+
+template <class ARGUMENTS>
+bool OptionDescriptor::validateOption( 
+    std::string_view name, 
+    const ARGUMENTS& args, 
+    Value* values ) const
 {
     if ( name != this->getName() )
     {
         return false;
     } 
-    HasParameters::validate( args );
+    const auto diagnostic{ tryValidateArguments( args, values ) };
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
     return true;
 }
 
@@ -228,8 +388,19 @@ CommandDescriptor::CommandDescriptor(
 : HasName(name)
 , HasDescription(description)
 , HasParameters(parameter_descriptors)
+, symbol{ Symbols::intern(name) }
 , options{option_descriptors}
 {
+    // The first of several options with the same name is the one that matches.
+    option_index.reserve( options.size() );
+    for( auto& option : options )
+        option_index.emplace_back( option->getSymbol(), option.get() );
+    std::stable_sort( option_index.begin(), option_index.end(), 
+        [](const auto& a, const auto& b) { return a.first < b.first; } );
+    option_index.erase( 
+        std::unique( option_index.begin(), option_index.end(), 
+            [](const auto& a, const auto& b) { return a.first == b.first; } ),
+        option_index.end() );
 }
 
 const OptionDescriptors& CommandDescriptor::getOptions() const
@@ -237,32 +408,105 @@ const OptionDescriptors& CommandDescriptor::getOptions() const
     return options;
 }
 
+const OptionDescriptor* CommandDescriptor::findOption(std::string_view name) const
+{
+    const auto option_symbol{ Symbols::find(name) };
+    return option_symbol != NoSymbol ? findOption(option_symbol) : nullptr;
+}
+
+const OptionDescriptor* CommandDescriptor::findOption(Symbol option_symbol) const
+{
+    auto option{ std::lower_bound( option_index.begin(), option_index.end(), option_symbol,
+        [](const auto& entry, Symbol s) { return entry.first < s; } ) };
+    if ( option == option_index.end() || option->first != option_symbol )
+        return nullptr;
+    return option->second;
+}
+
+Symbol CommandDescriptor::getSymbol() const
+{
+    return symbol;
+}
+
 bool CommandDescriptor::validate( const CommandLine& cmdline) const
 {
-    if ( cmdline.getCommand() != this->getName() )
+    return validateCommandLine( cmdline );
+}
+
+bool CommandDescriptor::validate( const CommandLineView& cmdline) const
+{
+    return validateCommandLine( cmdline );
+}
+
+bool CommandDescriptor::validate( CommandLineView& cmdline) const
+{
+    return validateCommandLine( cmdline );
+}
+
+Diagnostic CommandDescriptor::tryValidate( const CommandLine& cmdline) const
+{
+    return tryValidateCommandLine( cmdline );
+}
+
+Diagnostic CommandDescriptor::tryValidate( const CommandLineView& cmdline) const
+{
+    return tryValidateCommandLine( cmdline );
+}
+
+Diagnostic CommandDescriptor::tryValidate( CommandLineView& cmdline) const
+{
+    return tryValidateCommandLine( cmdline );
+}
+
+template <class COMMANDLINE>
+bool CommandDescriptor::validateCommandLine( COMMANDLINE& cmdline) const
+{
+    const auto diagnostic{ tryValidateCommandLine( cmdline ) };
+    if ( diagnostic.getCode() == ErrorCode::InvalidCommand )
         return false;
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
+    return true;
+}
 
-    HasParameters::validate(cmdline.getCommandParameters());
+template <class COMMANDLINE>
+Diagnostic CommandDescriptor::tryValidateCommandLine( COMMANDLINE& cmdline) const
+{
+    const std::string_view command{ cmdline.getCommandText() };
+    if ( !sameName( cmdline.getCommandSymbol(), command, symbol, this->getName() ) )
+        return Diagnostic( ErrorCode::InvalidCommand, command );
+
+    auto diagnostic{ tryValidateArguments( 
+        cmdline.getCommandParameterTexts(), 
+        commandParameterValues(cmdline) ) };
+    if ( !diagnostic.ok() )
+    {
+        if ( diagnostic.getToken().empty() )
+            diagnostic.setToken( command );
+        return diagnostic;
+    }
 
     for( int i{0}; i < cmdline.getOptionCount(); ++i )
     {
-        auto& opt_name{ cmdline.getOption(i) };
-        auto& opt_parameters{ cmdline.getOptionParameters(i) };
-        bool match;
-        for( auto& option_descriptor : options )
+        // Options, that have been resolved, are looked up by their symbols.
+        // Unknown ones are reported with their text.
+        const std::string_view option{ cmdline.getOptionText(i) };
+        const auto option_symbol{ cmdline.getOptionSymbol(i) };
+        auto option_descriptor{ 
+            option_symbol != NoSymbol ? findOption( option_symbol ) : findOption( option ) };
+        if ( !option_descriptor ) 
         {
-            match = option_descriptor->validate(opt_name,opt_parameters);
-            if (match)
-            {
-                break;
-            }
+            return Diagnostic( ErrorCode::InvalidOption, option );
         }
-        if (!match) 
+        diagnostic = validateOption( *option_descriptor, cmdline, i );
+        if ( !diagnostic.ok() )
         {
-            throw InvalidOptionException(opt_name);
+            if ( diagnostic.getToken().empty() )
+                diagnostic.setToken( option );
+            return diagnostic;
         }
     }
-    return true;
+    return Diagnostic();
 }
 
 //-----------------------------------------------------------------------------
@@ -279,11 +523,35 @@ DescriptorMap::DescriptorMap(const std::string& name)
 
 void DescriptorMap::attach(CommandDescriptorPtr p)
 {
-    for( auto descriptor : this->descriptors )
-        if ( p == descriptor || p->getName() == descriptor->getName() )
-            throw AlreadyInUseException(
-                p->getName() + " (CommandDescriptorMap::attach)");
-    this->descriptors.push_back(p);
+    attach( CommandDescriptors{ p } );
+}
+
+void DescriptorMap::attach(const CommandDescriptors& new_descriptors)
+{
+    auto p{ new_descriptors.begin() };
+    try
+    {
+        for( ; p != new_descriptors.end(); ++p )
+        {
+            const auto symbol{ (*p)->getSymbol() };
+            if ( !index.insert( symbol, p->get() ).second )
+                throw AlreadyInUseException(
+                    (*p)->getName() + " (CommandDescriptorMap::attach)");
+        }
+        descriptors.insert( descriptors.end(), new_descriptors.begin(), new_descriptors.end() );
+    }
+    catch(...)
+    {
+        for( auto attached{ new_descriptors.begin() }; attached != p; ++attached )
+            index.erase( (*attached)->getSymbol() );
+        throw;
+    }
+}
+
+void DescriptorMap::reserve(std::size_t count)
+{
+    descriptors.reserve(count);
+    index.reserve(count);
 }
 
 const std::vector<CommandDescriptorPtr>& DescriptorMap::getCommandDescriptors() const 
@@ -293,11 +561,35 @@ const std::vector<CommandDescriptorPtr>& DescriptorMap::getCommandDescriptors()
 
 bool DescriptorMap::validate(const CommandLine& cmdline) const 
 {
-    for( auto descriptor : descriptors )
-    {
-        if ( descriptor->validate(cmdline) )
-            return true;
-    }
-    return false;
+    return validateCommandLine(cmdline);
+}
+
+bool DescriptorMap::validate(const CommandLineView& cmdline) const 
+{
+    return validateCommandLine(cmdline);
+}
+
+bool DescriptorMap::validate(CommandLineView& cmdline) const 
+{
+    return validateCommandLine(cmdline);
+}
+
+const CommandDescriptor* DescriptorMap::find(std::string_view name) const
+{
+    return find( Symbols::find(name) );
+}
+
+const CommandDescriptor* DescriptorMap::find(Symbol symbol) const
+{
+    const auto descriptor{ index.find(symbol) };
+    return descriptor ? *descriptor : nullptr;
+}
+
+template <class COMMANDLINE>
+bool DescriptorMap::validateCommandLine(COMMANDLINE& cmdline) const 
+{
+    const auto symbol{ cmdline.getCommandSymbol() };
+    auto descriptor{ symbol != NoSymbol ? find( symbol ) : find( cmdline.getCommandText() ) };
+    return descriptor && descriptor->validate(cmdline);
 }
 
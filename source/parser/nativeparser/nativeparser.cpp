@@ -2,44 +2,111 @@
 #include "elrat/clp/errorhandling.hpp"
 
 #include "tokenhandler.hpp"
-
-#include <regex>
+#include "tokenizer.hpp"
 
 using namespace elrat::clp;
 
-static std::vector<std::string> tokenize(const std::string& input)
-{
-    std::vector<std::string> result{};
-    std::regex separating_regex("(\"[^\"]+\")|([^\\s=]+)|(=)");
-    auto begin{ std::sregex_iterator(
-      input.begin(), 
-      input.end(), 
-      separating_regex) 
-    };
-    auto end{ std::sregex_iterator() };
-    for( auto it{begin}; it!=end; it++ )
-        result.push_back( it->str() );
-    return result;
-}
-
 const std::string NativeParser::SyntaxDescription(
     "<command> "
     "[-<option-pack>] "
     "[--<option> [ = <option-parameter>]] "
     "[<command-parameter>]"); 
 
+namespace
+{
+    // Parses into a view, that the thread reuses, and copies it. Parsing 
+    // doesn't call out, so the view is never in use twice.
+    template <class PARSE>
+    void parseThroughView(PARSE parse, CommandLine& result)
+    {
+        thread_local CommandLineView view;
+        const auto diagnostic{ parse( view ) };
+        if ( !diagnostic.ok() )
+            diagnostic.raise();
+        result.assign( view );
+    }
+}
+
 CommandLine NativeParser::parse(const std::string& input) const 
 {
-    auto tokens{ tokenize(input) };
-    if ( !tokens.size() )
-       throw InputException("NativeParser::parse()", "Received empty string"); 
+    CommandLine result;
+    parse( input, result );
+    return result;
+}
+
+void NativeParser::parse(const std::string& input, CommandLine& result) const
+{
+    parseThroughView( 
+        [&](CommandLineView& view) { return tryParse( input, view ); }, result );
+}
+
+bool NativeParser::providesViews() const
+{
+    return true;
+}
+
+void NativeParser::parse(std::string_view input, CommandLineView& result) const
+{
+    const auto diagnostic{ tryParse( input, result ) };
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
+}
+
+Diagnostic NativeParser::tryParse(std::string_view input, CommandLineView& result) const
+{
+    Tokenizer tokenizer(input);
+    std::string_view token;
+    if ( !tokenizer.next(token) )
+       return Diagnostic( ErrorCode::EmptyInput ); 
+
+    result.clear();
+    TokenHandler token_handler(result);
+    do
+    {
+        const auto error{ token_handler.handle( token ) };
+        if ( error != ErrorCode::None )
+            return Diagnostic( error, token );
+    } while( tokenizer.next(token) );
+    return Diagnostic();
+}
+
+CommandLine NativeParser::parse(int argc, const char* const* argv) const
+{
+    CommandLine result;
+    parseThroughView( 
+        [&](CommandLineView& view) { return tryParse( argc, argv, view ); }, result );
+    return result;
+}
+
+Diagnostic NativeParser::tryParse(int argc, const char* const* argv, CommandLineView& result) const
+{
+    if ( argc < 1 )
+       return Diagnostic( ErrorCode::EmptyInput ); 
 
-    TokenHandler token_handler;
-    for(auto it = tokens.begin(); it != tokens.end(); ++it)
+    result.clear();
+    TokenHandler token_handler(result);
+    for( int i{0}; i < argc; i++ )
     {
-        token_handler.handle(*it);
+        std::string_view argument{ argv[i] };
+        std::string_view parameter;
+        const auto equal_sign{ argument.find('=') };
+        const bool split{ i > 0 && argument.starts_with("--") && equal_sign != std::string_view::npos };
+        if ( split )
+        {
+            parameter = argument.substr( equal_sign + 1 );
+            argument = argument.substr( 0, equal_sign );
+        }
+        auto error{ token_handler.handle( argument ) };
+        if ( error == ErrorCode::None && split )
+        {
+            error = token_handler.handle( "=" );
+            if ( error == ErrorCode::None )
+                error = token_handler.handle( parameter );
+        }
+        if ( error != ErrorCode::None )
+            return Diagnostic( error, argument );
     }
-    return token_handler.fetch();
+    return Diagnostic();
 }
 
 const std::string& NativeParser::getSyntaxDescription() const 
@@ -0,0 +1,17 @@
+#include "parser/nativeparser/tokenclassification.hpp"
+
+const RegEx token::regex::IsIdentifierPlus(
+    "[a-zA-Z_][\\w\\-_]*"
+);
+
+const RegEx token::regex::IsOption(
+    "--[_a-zA-Z][\\w\\-]*"
+);
+
+const RegEx token::regex::IsOptionPack(
+    "-[a-zA-Z]+"
+);
+
+const RegEx token::regex::IsEqualSign(
+    "[=]"
+);
@@ -0,0 +1,60 @@
+#ifndef NATIVEPARSER_TOKENCLASSIFICATION_HPP
+#define NATIVEPARSER_TOKENCLASSIFICATION_HPP
+
+#include <string_view>
+
+#include "common/lexical.hpp"
+#include "common/regex.hpp"
+
+// Classification of the tokens that are fed to the TokenHandler.
+namespace token
+{
+    // [a-zA-Z_][\w\-_]*
+    constexpr bool IsIdentifierPlus(std::string_view token)
+    {
+        if ( token.empty() || !( lexical::isAlpha(token[0]) || token[0] == '_' ) )
+            return false;
+        for( std::size_t i{1}; i < token.size(); i++ )
+            if ( !lexical::isWordCharacter(token[i]) && token[i] != '-' )
+                return false;
+        return true;
+    }
+
+    // --[_a-zA-Z][\w\-]*
+    constexpr bool IsOption(std::string_view token)
+    {
+        return token.size() > 2 
+            && token[0] == '-' 
+            && token[1] == '-' 
+            && IsIdentifierPlus( token.substr(2) );
+    }
+
+    // -[a-zA-Z]+
+    constexpr bool IsOptionPack(std::string_view token)
+    {
+        if ( token.size() < 2 || token[0] != '-' )
+            return false;
+        for( std::size_t i{1}; i < token.size(); i++ )
+            if ( !lexical::isAlpha(token[i]) )
+                return false;
+        return true;
+    }
+
+    // [=]
+    constexpr bool IsEqualSign(std::string_view token)
+    {
+        return token == "=";
+    }
+
+    // Reference implementation. The TokenHandler uses it instead,
+    // if the library is built with CLP_USE_REGEX.
+    namespace regex
+    {
+        extern const RegEx IsIdentifierPlus;
+        extern const RegEx IsOption;
+        extern const RegEx IsOptionPack;
+        extern const RegEx IsEqualSign;
+    }
+}
+
+#endif
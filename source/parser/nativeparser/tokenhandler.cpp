@@ -1,126 +1,114 @@
 
-#include "elrat/clp/errorhandling.hpp"
-
 #include "parser/nativeparser/tokenhandler.hpp"
-#include "common/regex.hpp"
-
-using elrat::clp::CommandLine;
-using elrat::clp::InputException;
-
-const RegEx IsIdentifierPlus(
-    "[a-zA-Z_][\\w\\-_]*"
-);
+#include "parser/nativeparser/tokenclassification.hpp"
 
-const RegEx IsOption(
-    "--[_a-zA-Z][\\w\\-]*"
-);
+using elrat::clp::CommandLineView;
+using elrat::clp::ErrorCode;
 
-const RegEx IsOptionPack(
-    "-[a-zA-Z]+"
-);
+#ifdef CLP_USE_REGEX
+using namespace token::regex;
+#else
+using namespace token;
+#endif
 
-const RegEx IsEqualSign(
-    "[=]"
-);
-
-TokenHandler::TokenHandler()
-: mState{std::make_unique<InitialState>(*this,mCmdLine)}
+TokenHandler::TokenHandler(CommandLineView& commandLine)
+: mCmdLine{commandLine}
+, mState{State::Initial}
 {
 }
 
-void TokenHandler::handle(const std::string& token)
-{
-  mState->handle(token);
-}
-
-CommandLine&& TokenHandler::fetch() 
-{
-  return std::move(mCmdLine);
-}
-
-TokenHandler::State::State(TokenHandler& tokenHandler, CommandLine& commandLine)
-: token_handler{tokenHandler}
-, command_line{commandLine}
-{
-}
-
-TokenHandler::State::~State() 
+ErrorCode TokenHandler::handle(std::string_view token)
 {
+  switch( mState )
+  {
+    case State::Initial:
+      return handleInitial(token);
+    case State::Default:
+      return handleDefault(token);
+    case State::ReceivedOption:
+      return handleReceivedOption(token);
+    case State::ReceivedEqualSign:
+      return handleReceivedEqualSign(token);
+  }
+  return ErrorCode::None;
 }
 
-bool TokenHandler::State::add_option(const std::string& option)
+bool TokenHandler::add_option(std::string_view option)
 {
-    if (command_line.optionExists(option))
+    if (mCmdLine.optionExists(option))
         return false;
-    command_line.addOption(option);
+    mCmdLine.addOption(option);
     return true;
 }
 
-bool TokenHandler::State::add_long_option(const std::string& token)
+bool TokenHandler::add_long_option(std::string_view token)
 {
     static const int preceeding_dashes = 2;
     auto option{ token.substr(preceeding_dashes) };
     return add_option(option);
 }
 
-bool TokenHandler::State::add_option_pack(const std::string& token)
+bool TokenHandler::add_option_pack(std::string_view token)
 {
-    for( int i{1}; i < token.size(); i++ ) // omit the single preceeding dash
+    for( std::size_t i{1}; i < token.size(); i++ ) // omit the single preceeding dash
     {
-        const std::string option(1,token[i]);
-        if (!add_option(option))
+        if (!add_option(token.substr(i,1)))
             return false;
     }
     return true;
 }
 
 
-void TokenHandler::InitialState::handle(const std::string& token)
+ErrorCode TokenHandler::handleInitial(std::string_view token)
 {
   if ( !IsIdentifierPlus(token) ) {
-    throw InputException(token," is not an Identifier-Plus");
+    return ErrorCode::InvalidCommandName;
   }
-  command_line.setCommand(token);
-  token_handler.setNextState<DefaultState>();
+  mCmdLine.setCommand(token);
+  mState = State::Default;
+  return ErrorCode::None;
 }
 
-void TokenHandler::DefaultState::handle(const std::string& token)
+ErrorCode TokenHandler::handleDefault(std::string_view token)
 {
   if ( IsEqualSign(token) )
   {
-    throw InputException(token, " not allowed in this context.");
+    return ErrorCode::UnexpectedToken;
   }
   if ( IsOptionPack(token) ) 
   {
     bool redundantOptionsFound{ !add_option_pack(token) };
     if (redundantOptionsFound)
     {
-      throw InputException(token, "contains option that already exists.");
+      return ErrorCode::RedundantOptionInPack;
     }
   }
   else if ( IsOption(token) ) {
     if ( !add_long_option(token) )
-      throw InputException(token, "Already exists");
-    token_handler.setNextState<ReceivedOptionState>();
+      return ErrorCode::RedundantOption;
+    mState = State::ReceivedOption;
   }
   else {
-    command_line.addCommandParameter(token);
+    mCmdLine.addCommandParameter(token);
   }
+  return ErrorCode::None;
 }
 
-void TokenHandler::ReceivedOptionState::handle(const std::string& token)
+// Sub-state of the default state. Option-packs and command parameters
+// do not leave it, as they did not leave the former ReceivedOptionState.
+ErrorCode TokenHandler::handleReceivedOption(std::string_view token)
 {
   if( IsEqualSign(token) ) 
   {
-    token_handler.setNextState<ReceivedEqualSignState>();
-  }
-  else {
-    DefaultState::handle(token);
+    mState = State::ReceivedEqualSign;
+    return ErrorCode::None;
   }
+  return handleDefault(token);
 }
 
-void TokenHandler::ReceivedEqualSignState::handle(const std::string& token)
+ErrorCode TokenHandler::handleReceivedEqualSign(std::string_view token)
 {
-  command_line.addOptionParameter(token);
-  token_handler.setNextState<DefaultState>();
+  mCmdLine.addOptionParameter(token);
+  mState = State::Default;
+  return ErrorCode::None;
 }
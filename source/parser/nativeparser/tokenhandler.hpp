@@ -1,82 +1,45 @@
 #ifndef NATIVEPARSER_TOKENHANDLER_HPP
 #define NATIVEPARSER_TOKENHANDLER_HPP
 
-#include <memory>
-#include <string>
+#include <string_view>
 
-#include "elrat/clp/commandline.hpp"
+#include "elrat/clp/commandlineview.hpp"
+#include "elrat/clp/diagnostic.hpp"
 
+// Fills the given CommandLineView with the tokens it is fed.
+// Implements the state machine in docs/img/native-parser-state-machine.png.
+// The current state is a plain value, so state transitions don't allocate.
+// A token that is not accepted is reported by its error code.
 class TokenHandler
 {
 public:
-    TokenHandler();
+    TokenHandler(elrat::clp::CommandLineView&);
     TokenHandler(const TokenHandler&)=delete;
-    TokenHandler(TokenHandler&&)=default;
+    TokenHandler(TokenHandler&&)=delete;
     TokenHandler& operator=(const TokenHandler&)=delete;
-    TokenHandler& operator=(TokenHandler&&)=default;
+    TokenHandler& operator=(TokenHandler&&)=delete;
     ~TokenHandler()=default;
-    void handle(const std::string& token);
-    
-    template <class NextState>
-    void setNextState() {
-        mState = std::make_unique<NextState>(*this,mCmdLine);
-    }
-
-    elrat::clp::CommandLine&& fetch();
+    elrat::clp::ErrorCode handle(std::string_view token);
 private:
-    class State;
-    class InitialState;        
-    class DefaultState;        
-    class ReceivedOptionState;  
-    class ReceivedEqualSignState;
-
-
-    elrat::clp::CommandLine mCmdLine;
-    std::unique_ptr<State>  mState;
-};
-
-class TokenHandler::State 
-{
-public:
-    State(TokenHandler&, elrat::clp::CommandLine&);
-    virtual ~State();
-    virtual void handle(const std::string& token) = 0;
-protected:
-    bool add_option(const std::string& option);
-    bool add_long_option(const std::string& token);
-    bool add_option_pack(const std::string& token);
-
-    TokenHandler&                   token_handler;
-    elrat::clp::CommandLine&    command_line;
-};
-
-class TokenHandler::InitialState : public TokenHandler::State 
-{
-public:
-    using State::State;
-    void handle(const std::string& token);
-};
-
-class TokenHandler::DefaultState : public TokenHandler::State 
-{
-public:
-    using State::State;
-    void handle(const std::string& token);
-};
-
-class TokenHandler::ReceivedOptionState: public TokenHandler::DefaultState 
-{
-public:
-    using DefaultState::DefaultState;
-    void handle(const std::string& token);
-};
-
-class TokenHandler::ReceivedEqualSignState: public TokenHandler::State 
-{
-public:
-    using State::State;
-    void handle(const std::string& token);
+    enum class State
+    {
+        Initial,
+        Default,
+        ReceivedOption,
+        ReceivedEqualSign
+    };
+
+    elrat::clp::CommandLineView& mCmdLine;
+    State                        mState;
+
+    elrat::clp::ErrorCode handleInitial(std::string_view token);
+    elrat::clp::ErrorCode handleDefault(std::string_view token);
+    elrat::clp::ErrorCode handleReceivedOption(std::string_view token);
+    elrat::clp::ErrorCode handleReceivedEqualSign(std::string_view token);
+
+    bool add_option(std::string_view option);
+    bool add_long_option(std::string_view token);
+    bool add_option_pack(std::string_view token);
 };
 
 #endif
-
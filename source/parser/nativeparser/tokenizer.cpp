@@ -0,0 +1,46 @@
+#include "parser/nativeparser/tokenizer.hpp"
+#include "common/lexical.hpp"
+
+using lexical::isWhitespace;
+
+static bool isDelimiter(char c)
+{
+    return c == '=' || isWhitespace(c);
+}
+
+Tokenizer::Tokenizer(std::string_view s)
+: input{s}
+, position{0}
+{
+}
+
+bool Tokenizer::next(std::string_view& token)
+{
+    while( position < input.size() && isWhitespace(input[position]) )
+        ++position;
+    if ( position == input.size() )
+        return false;
+
+    const std::size_t begin{ position };
+    if ( input[position] == '=' )
+    {
+        token = input.substr( begin, 1 );
+        ++position;
+        return true;
+    }
+    if ( input[position] == '"' )
+    {
+        // Empty or unterminated quotes are read like any other character.
+        const auto closing{ input.find('"', begin + 1) };
+        if ( closing != std::string_view::npos && closing > begin + 1 )
+        {
+            position = closing + 1;
+            token = input.substr( begin, position - begin );
+            return true;
+        }
+    }
+    while( position < input.size() && !isDelimiter(input[position]) )
+        ++position;
+    token = input.substr( begin, position - begin );
+    return true;
+}
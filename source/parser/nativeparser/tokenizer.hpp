@@ -0,0 +1,22 @@
+#ifndef NATIVEPARSER_TOKENIZER_HPP
+#define NATIVEPARSER_TOKENIZER_HPP
+
+#include <cstddef>
+#include <string_view>
+
+// Splits the input into tokens within a single pass. A token is either
+//  - a quoted string (at least one character between the quotes),
+//  - a single equal sign or
+//  - a sequence of characters, that are neither whitespace nor equal signs.
+// Whitespace only separates tokens. Quotes remain part of the token.
+class Tokenizer
+{
+public:
+    Tokenizer(std::string_view input);
+    bool next(std::string_view& token);
+private:
+    std::string_view input;
+    std::size_t position;
+};
+
+#endif
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <stdexcept>
+
 #include "elrat/clp/parser.hpp"
+#include "elrat/clp/errorhandling.hpp"
+#include "common/lexical.hpp"
 
 using namespace elrat::clp;
 
@@ -7,4 +12,53 @@ Parser::~Parser()
     // virtual destructor
 }
 
+void Parser::parse( const std::string& input, CommandLine& result ) const
+{
+    result = parse( input );
+}
+
+bool Parser::providesViews() const
+{
+    return false;
+}
+
+void Parser::parse( std::string_view, CommandLineView& ) const
+{
+    throw std::logic_error("Parser::parse(): Parser does not provide views.");
+}
+
 
+
+Diagnostic Parser::tryParse( std::string_view input, CommandLineView& result ) const
+{
+    try
+    {
+        parse( input, result );
+    }
+    catch( const InputException& )
+    {
+        return Diagnostic::FromCurrentException();
+    }
+    return Diagnostic();
+}
+
+CommandLine Parser::parse( int argc, const char* const* argv ) const
+{
+    std::string input;
+    for( int i{0}; i < argc; i++ )
+    {
+        const std::string_view argument{ argv[i] };
+        if ( i )
+            input += ' ';
+        if ( std::any_of( argument.begin(), argument.end(), lexical::isWhitespace ) )
+            input.append("\"").append(argument).append("\"");
+        else
+            input += argument;
+    }
+    return parse( input );
+}
+
+Diagnostic Parser::tryParse( int, const char* const*, CommandLineView& ) const
+{
+    throw std::logic_error("Parser::tryParse(): Parser does not provide views.");
+}
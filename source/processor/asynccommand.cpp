@@ -0,0 +1,20 @@
+#include "elrat/clp/asynccommand.hpp"
+
+#include <future>
+#include <memory>
+
+using namespace elrat::clp;
+
+void AsyncCommand::execute(const CommandLine& cmdline)
+{
+    // Shared, as the completion may still use it when get() returns
+    auto finished{ std::make_shared<std::promise<void>>() };
+    auto future{ finished->get_future() };
+    executeAsync( cmdline ).start( nullptr, [finished](std::exception_ptr exception) {
+        if ( exception )
+            finished->set_exception( exception );
+        else
+            finished->set_value();
+    });
+    future.get();
+}
@@ -0,0 +1,92 @@
+#include "elrat/clp/asynctask.hpp"
+
+using namespace elrat::clp;
+
+AsyncTask::AsyncTask(Handle h)
+: handle{h}
+{
+}
+
+AsyncTask::AsyncTask(AsyncTask&& other) noexcept
+: handle{ std::exchange( other.handle, nullptr ) }
+{
+}
+
+AsyncTask& AsyncTask::operator=(AsyncTask&& other) noexcept
+{
+    if ( this != &other )
+    {
+        if ( handle )
+            handle.destroy();
+        handle = std::exchange( other.handle, nullptr );
+    }
+    return *this;
+}
+
+AsyncTask::~AsyncTask()
+{
+    if ( handle )
+        handle.destroy();
+}
+
+void AsyncTask::start(Executor* executor, Completion completion)
+{
+    // From now on, the coroutine destroys itself.
+    auto h{ std::exchange( handle, nullptr ) };
+    h.promise().executor = executor;
+    h.promise().completion = std::move(completion);
+    h.resume();
+}
+
+// The awaiting coroutine continues on the same executor.
+std::coroutine_handle<> AsyncTask::await_suspend(Handle awaiting) noexcept
+{
+    handle.promise().continuation = awaiting;
+    handle.promise().executor = awaiting.promise().executor;
+    return handle;
+}
+
+void AsyncTask::await_resume() const
+{
+    if ( handle.promise().exception )
+        std::rethrow_exception( handle.promise().exception );
+}
+
+// An awaited coroutine continues the awaiting one, which destroys it. A
+// started one has no owner, so it destroys itself before its completion
+// is called, which may end whatever the coroutine refers to.
+std::coroutine_handle<> AsyncTask::FinalAwaiter::await_suspend(Handle handle) noexcept
+{
+    auto& promise{ handle.promise() };
+    if ( promise.continuation )
+        return promise.continuation;
+    auto completion{ std::move(promise.completion) };
+    auto exception{ promise.exception };
+    handle.destroy();
+    if ( completion )
+        completion( exception );
+    return std::noop_coroutine();
+}
+
+Resumer::Resumer(Executor* e, std::coroutine_handle<> h)
+: executor{e}
+, handle{h}
+{
+}
+
+void Resumer::operator()() const
+{
+    if ( executor )
+        executor->post( [h = handle]{ h.resume(); } );
+    else
+        handle.resume();
+}
+
+bool Rescheduling::await_suspend(AsyncTask::Handle handle)
+{
+    auto executor{ handle.promise().executor };
+    if ( !executor )
+        return false;
+    executor->post( [handle]{ handle.resume(); } );
+    return true;
+}
@@ -5,9 +5,9 @@
 using namespace elrat::clp;
 
 HelpCommand::HelpCommand(
-    const std::vector<DescriptorMapPtr>& v,
+    DescriptorMapsSource source,
     std::ostream* p )
-: descriptor_maps{v}
+: descriptor_maps{source}
 , os{p}
 {
 }
@@ -19,20 +19,16 @@ void HelpCommand::setOutputStream(std::ostream* p)
 
 void HelpCommand::execute(const CommandLine& cmdline)
 {
-    for( DescriptorMapPtr map : descriptor_maps )
+    for( DescriptorMapPtr map : descriptor_maps() )
         printDescriptorMap( *os, map );
 }
 
-CommandDescriptorPtr HelpDescriptor::descriptor;
-
 CommandDescriptorPtr HelpDescriptor::Create()
 {
-    if(!descriptor)
-    {
-        descriptor = CommandDescriptor::Create(
+    static const CommandDescriptorPtr descriptor{ 
+        CommandDescriptor::Create(
             "help","Built-in help command."
-        );
-    }
+        ) };
     return descriptor;
 }
 
@@ -41,16 +37,12 @@ void ExitCommand::execute(const CommandLine& cmdline)
     std::exit(0);
 }
 
-CommandDescriptorPtr ExitDescriptor::descriptor;
-
 CommandDescriptorPtr ExitDescriptor::Create()
 {
-    if (!descriptor)
-    {
-        descriptor = CommandDescriptor::Create(
+    static const CommandDescriptorPtr descriptor{ 
+        CommandDescriptor::Create(
             "exit", "Exit program."
-        );
-    }
+        ) };
     return descriptor;
 }
 
@@ -58,7 +50,7 @@ void printDescriptorMap(std::ostream& os, DescriptorMapPtr p)
 {
     auto& map_name{ p->getName() };
     os << map_name << '\n';
-    for( int i{0}; i<map_name.size(); i++)
+    for( std::size_t i{0}; i<map_name.size(); i++)
         os << '-';
     os << '\n';
     auto& descriptors{ p->getCommandDescriptors() };
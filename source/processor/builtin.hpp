@@ -4,6 +4,7 @@
 #include "elrat/clp/command.hpp"
 #include "elrat/clp/descriptors.hpp"
 
+#include <functional>
 #include <iostream>
 #include <vector>
 
@@ -11,23 +12,24 @@ class HelpCommand
 : public elrat::clp::Command
 {
 public:
+    // Returns the descriptor maps to be printed
+    using DescriptorMapsSource = std::function<std::vector<elrat::clp::DescriptorMapPtr>()>;
     HelpCommand(
-        const std::vector<elrat::clp::DescriptorMapPtr>&,
+        DescriptorMapsSource,
         std::ostream* = &std::cout);
     void setOutputStream(std::ostream*);
     virtual void execute(const elrat::clp::CommandLine&);
 private:
-    const std::vector<elrat::clp::DescriptorMapPtr>& descriptor_maps;
+    DescriptorMapsSource descriptor_maps;
     std::ostream* os;
 };
 
 class HelpDescriptor
 {
 public:
+    // Returns the same descriptor each time (safe to call concurrently)
     static elrat::clp::CommandDescriptorPtr Create();
     HelpDescriptor() = delete;
-private:
-    static elrat::clp::CommandDescriptorPtr descriptor;
 };
 
 class ExitCommand
@@ -40,10 +42,9 @@ public:
 class ExitDescriptor
 {
 public:
+    // Returns the same descriptor each time (safe to call concurrently)
     static elrat::clp::CommandDescriptorPtr Create();
     ExitDescriptor() = delete;
-private:
-    static elrat::clp::CommandDescriptorPtr descriptor;
 };
 
 void printDescriptorMap(std::ostream&, elrat::clp::DescriptorMapPtr);
@@ -5,3 +5,8 @@ using namespace elrat::clp;
 Command::~Command()
 {
 }
+
+void Command::execute(const CommandLineView& cmdline)
+{
+    execute( CommandLine(cmdline) );
+}
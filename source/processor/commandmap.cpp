@@ -10,7 +10,7 @@ void CommandMap::attach(const std::string& name, CommandPtr ptr)
     throwIfEmpty(name, where);
     throwIfNull(ptr, where);
     
-    std::vector<CommandPtr>& pointers = commands[name];
+    std::vector<CommandPtr>& pointers = entries.insert( Symbols::intern(name), Entry{} ).first->commands;
     for(auto& p : pointers)
         if (p == ptr)
             throw AlreadyInUseException("CommandMap::attach(): CommandPtr");
@@ -18,35 +18,104 @@ void CommandMap::attach(const std::string& name, CommandPtr ptr)
     pointers.push_back( ptr );
 }
 
+void CommandMap::attach(const CommandDescriptorPtr& descriptor)
+{
+    static const std::string where{"CommandMap::attach()"};
+    if (!descriptor)
+        throw NullptrAssignmentException(where);
+    throwIfEmpty(descriptor->getName(), where);
+
+    auto& entry{ *entries.insert( descriptor->getSymbol(), Entry{} ).first };
+    if ( !entry.descriptor )
+        entry.descriptor = descriptor.get();
+}
+
 void CommandMap::detach(const std::string& name, CommandPtr ptr)
 {
     throwIfEmpty(name,"CommandMap::detach()");
 
-    std::vector<CommandPtr>& pointers{ commands[name] };
+    const auto symbol{ Symbols::find(name) };
+    auto entry{ entries.find(symbol) };
+    if ( !entry )
+        return;
+    std::vector<CommandPtr>& pointers{ entry->commands };
     if (ptr)
+    {
         for( auto current = pointers.begin(); current != pointers.end(); current++ )
             if ( *current == ptr )
             {
                 pointers.erase(current);
-                return;
+                break;
             }
+    }
     else
+    {
         pointers.clear();
+    }
+    if ( pointers.empty() && !entry->descriptor )
+        entries.erase(symbol);
+}
+
+const CommandMap::Entry* CommandMap::find(std::string_view name) const
+{
+    return find( Symbols::find(name) );
+}
+
+const CommandMap::Entry* CommandMap::find(Symbol symbol) const
+{
+    return entries.find(symbol);
+}
+
+const CommandMap::Entry* CommandMap::find(const CommandLine& cmdline) const
+{
+    return findEntry( cmdline );
+}
+
+const CommandMap::Entry* CommandMap::find(const CommandLineView& cmdline) const
+{
+    return findEntry( cmdline );
+}
+
+template <class COMMANDLINE>
+const CommandMap::Entry* CommandMap::findEntry(const COMMANDLINE& cmdline) const
+{
+    const auto symbol{ cmdline.getCommandSymbol() };
+    return ( symbol != NoSymbol ) ? find( symbol ) : find( cmdline.getCommandText() );
 }
 
 void CommandMap::invoke(const CommandLine& cmdline) const
 {
-    auto& key{ cmdline.getCommand() };
-    auto& cmds{ this->find( key ) };
-    for( auto cmd : cmds )
+    invoke( findCommands( cmdline ), cmdline );
+}
+
+void CommandMap::invoke(const CommandLineView& cmdline) const
+{
+    invoke( findCommands( cmdline ), cmdline );
+}
+
+void CommandMap::invoke(const Entry& entry, const CommandLine& cmdline) const
+{
+    if ( entry.commands.empty() )
+        throw CommandNotFoundException( std::string(cmdline.getCommandText()) );
+    for( auto& cmd : entry.commands )
+        cmd->execute(cmdline);
+}
+
+void CommandMap::invoke(const Entry& entry, const CommandLineView& cmdline) const
+{
+    if ( entry.commands.empty() )
+        throw CommandNotFoundException( std::string(cmdline.getCommandText()) );
+    for( auto& cmd : entry.commands )
         cmd->execute(cmdline);
 }
 
-const std::vector<CommandPtr>& CommandMap::find(const std::string& name) const 
+template <class COMMANDLINE>
+const CommandMap::Entry& CommandMap::findCommands(const COMMANDLINE& cmdline) const 
 {
-    if (commands.find(name) == commands.end())
-        throw CommandNotFoundException(name);
-    return commands.at(name);
+    auto entry{ find(cmdline) };
+    if ( !entry )
+        throw CommandNotFoundException( std::string(cmdline.getCommandText()) );
+    return *entry;
 }
 
 void CommandMap::throwIfEmpty(const std::string& candidate, const std::string& where)
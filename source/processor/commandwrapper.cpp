@@ -2,6 +2,7 @@
 #include "elrat/clp/errorhandling.hpp"
 
 using elrat::clp::CommandLine;
+using elrat::clp::CommandLineView;
 
 CommandWrapper::CommandWrapper( Function f )
 : function(f)
@@ -10,9 +11,39 @@ CommandWrapper::CommandWrapper( Function f )
         throw elrat::clp::NullptrAssignmentException("CommandWrapper(Function f)");
 }
 
+CommandWrapper::CommandWrapper( ViewFunction f )
+: view_function(f)
+{
+    if (!view_function)
+        throw elrat::clp::NullptrAssignmentException("CommandWrapper(ViewFunction f)");
+}
+
 void CommandWrapper::execute(const CommandLine& cmdline)
 {
-    function(cmdline);
+    if (function)
+        function(cmdline);
+    else
+        view_function(CommandLineView(cmdline));
 }
 
+void CommandWrapper::execute(const CommandLineView& cmdline)
+{
+    if (view_function)
+        view_function(cmdline);
+    else
+        function(CommandLine(cmdline));
+}
+
+
 
+AsyncCommandWrapper::AsyncCommandWrapper( Function f )
+: function(f)
+{
+    if (!function)
+        throw elrat::clp::NullptrAssignmentException("AsyncCommandWrapper(Function f)");
+}
+
+elrat::clp::AsyncTask AsyncCommandWrapper::executeAsync(CommandLine cmdline)
+{
+    return function( std::move(cmdline) );
+}
@@ -2,6 +2,7 @@
 #define COMMANDWRAPPER_HPP
 
 #include <functional>
+#include "elrat/clp/asynccommand.hpp"
 #include "elrat/clp/processor.hpp"
 
 class CommandWrapper
@@ -9,8 +10,23 @@ class CommandWrapper
 {
 public:
     using Function = std::function<void(const elrat::clp::CommandLine&)>;
+    using ViewFunction = std::function<void(const elrat::clp::CommandLineView&)>;
     CommandWrapper( Function );
+    CommandWrapper( ViewFunction );
     virtual void execute(const elrat::clp::CommandLine&);
+    virtual void execute(const elrat::clp::CommandLineView&);
+private:
+    Function function;
+    ViewFunction view_function;
+};
+
+class AsyncCommandWrapper
+: public elrat::clp::AsyncCommand
+{
+public:
+    using Function = std::function<elrat::clp::AsyncTask(elrat::clp::CommandLine)>;
+    AsyncCommandWrapper( Function );
+    virtual elrat::clp::AsyncTask executeAsync(elrat::clp::CommandLine);
 private:
     Function function;
 };
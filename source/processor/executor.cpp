@@ -0,0 +1,188 @@
+#include "elrat/clp/executor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace elrat::clp;
+
+namespace
+{
+    // The executor and queue of the current thread, if it is a worker
+    thread_local const Executor* current_executor{ nullptr };
+    thread_local std::size_t     current_queue{ 0 };
+}
+
+ExecutorPtr Executor::Create(std::size_t thread_count)
+{
+    return std::make_shared<Executor>(thread_count);
+}
+
+Executor::Executor(std::size_t thread_count)
+{
+    if ( thread_count == 0 )
+        thread_count = std::max( 1u, std::thread::hardware_concurrency() );
+    for( std::size_t i{0}; i < thread_count; i++ )
+        queues.push_back( std::make_unique<Queue>() );
+    running = thread_count;
+    for( std::size_t i{0}; i < thread_count; i++ )
+        threads.emplace_back( [this, i]{ run(i); } );
+}
+
+Executor::~Executor()
+{
+    shutdown();
+}
+
+std::size_t Executor::getThreadCount() const
+{
+    return queues.size();
+}
+
+// Counted and queued under the idle lock: no thread misses the task going
+// to sleep or stopping, and a thread, that takes it, finds it counted.
+void Executor::post(Task task)
+{
+    const std::size_t index{
+        current_executor == this
+            ? current_queue
+            : next_queue++ % queues.size() };
+    {
+        std::lock_guard<std::mutex> lock( idle_mutex );
+        if ( closed )
+            throw std::logic_error("Executor::post(): Executor has been shut down.");
+        pending++;
+        std::lock_guard<std::mutex> queue_lock( queues[index]->mutex );
+        queues[index]->tasks.push_back( std::move(task) );
+    }
+    wakeup.notify_one();
+}
+
+void Executor::post(std::string_view key, Task task)
+{
+    post( key, Job( [task = std::move(task)](Task done) {
+        task();
+        done();
+    }));
+}
+
+void Executor::post(std::string_view key, Job job)
+{
+    {
+        std::lock_guard<std::mutex> lock( strand_mutex );
+        if ( auto waiting{ strands.find(key) } )
+        {
+            waiting->push_back( std::move(job) );
+            return;
+        }
+        // The key's entry exists, while one of its jobs is posted or running
+        strands.insert( key, {} );
+    }
+    try
+    {
+        post( [this, key = std::string(key), job = std::move(job)]() mutable {
+            runStrand( key, std::move(job) );
+        });
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock( strand_mutex );
+        strands.erase( key );
+        throw;
+    }
+}
+
+void Executor::runStrand(const std::string& key, Job job)
+{
+    job( [this, key]{ continueStrand(key); } );
+}
+
+void Executor::continueStrand(const std::string& key)
+{
+    Job next;
+    {
+        std::lock_guard<std::mutex> lock( strand_mutex );
+        auto waiting{ strands.find(key) };
+        if ( waiting->empty() )
+        {
+            strands.erase(key);
+            return;
+        }
+        next = std::move( waiting->front() );
+        waiting->pop_front();
+    }
+    // Posted rather than run here, so other keys get their turn
+    post( [this, key, next = std::move(next)]() mutable {
+        runStrand( key, std::move(next) );
+    });
+}
+
+void Executor::shutdown()
+{
+    std::lock_guard<std::mutex> shutdown_lock( shutdown_mutex );
+    if ( stopped )
+        return;
+    {
+        std::lock_guard<std::mutex> lock( idle_mutex );
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for( auto& thread : threads )
+        thread.join();
+    stopped = true;
+}
+
+void Executor::run(std::size_t index)
+{
+    current_executor = this;
+    current_queue = index;
+    for(;;)
+    {
+        Task task;
+        if ( take(index, task) )
+        {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock( idle_mutex );
+        wakeup.wait( lock, [this]{ return pending > 0 || stopping; } );
+        // Threads only stop once there is nothing left. A task, that is
+        // still running, may post more, and so may other threads; the
+        // remaining threads run (or steal) them. Posting fails once the
+        // last thread has stopped.
+        if ( pending == 0 && stopping )
+        {
+            if ( --running == 0 )
+                closed = true;
+            return;
+        }
+    }
+}
+
+bool Executor::take(std::size_t index, Task& task)
+{
+    {
+        auto& own{ *queues[index] };
+        std::lock_guard<std::mutex> lock( own.mutex );
+        if ( !own.tasks.empty() )
+        {
+            task = std::move( own.tasks.front() );
+            own.tasks.pop_front();
+            pending--;
+            return true;
+        }
+    }
+    for( std::size_t i{1}; i < queues.size(); i++ )
+    {
+        auto& other{ *queues[ (index + i) % queues.size() ] };
+        std::lock_guard<std::mutex> lock( other.mutex );
+        if ( !other.tasks.empty() )
+        {
+            task = std::move( other.tasks.back() );
+            other.tasks.pop_back();
+            pending--;
+            return true;
+        }
+    }
+    return false;
+}
@@ -1,83 +1,921 @@
 #include "elrat/clp/processor.hpp"
 #include "elrat/clp/errorhandling.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <thread>
+#include <utility>
+
+#include "common/epoch.hpp"
+#include "common/lexical.hpp"
+#include "common/localpool.hpp"
+#include "common/mappedfile.hpp"
+#include "common/ringbuffer.hpp"
 #include "commandwrapper.hpp"
 #include "builtin.hpp"
 
 using namespace elrat::clp;
 
+namespace
+{
+    // Consecutive lines for the same command share the lookup
+    class CachedLookup
+    {
+    public:
+        explicit CachedLookup(const CommandMap& c)
+        : commands{c}
+        {
+        }
+
+        template <class COMMANDLINE>
+        const CommandMap::Entry* find(const COMMANDLINE& cmdline)
+        {
+            const auto symbol{ cmdline.getCommandSymbol() };
+            if ( !resolved || symbol == NoSymbol || symbol != symbol_of_entry )
+            {
+                entry = commands.find( cmdline );
+                symbol_of_entry = symbol;
+                resolved = true;
+            }
+            return entry;
+        }
+    private:
+        const CommandMap&        commands;
+        const CommandMap::Entry* entry{ nullptr };
+        Symbol                   symbol_of_entry{ NoSymbol };
+        bool                     resolved{ false };
+    };
+
+    // A line on its way through the pipeline of processPipelined(). The
+    // items circulate: the last stage returns them to the first one, so 
+    // their buffers are reused.
+    struct PipelineItem
+    {
+        CommandLineView          cmdline;
+        const CommandMap::Entry* entry{ nullptr };
+        LineStatus               status{ LineStatus::Processed };
+    };
+
+    const std::uint32_t PipelineDepth{ 256 };     // lines in flight
+    const std::size_t   PipelineMinimum{ 1024 };  // lines worth two threads
+
+    // The commands of a submitted line, of which at least one is an
+    // AsyncCommand, one after the other
+    AsyncTask invokeAll(std::vector<CommandPtr> commands, CommandLine cmdline)
+    {
+        for( auto& command : commands )
+        {
+            if ( auto async{ std::dynamic_pointer_cast<AsyncCommand>(command) } )
+                co_await async->executeAsync( cmdline );
+            else
+                command->execute( cmdline );
+        }
+    }
+
+    bool isAsync(const CommandPtr& command)
+    {
+        return dynamic_cast<const AsyncCommand*>( command.get() ) != nullptr;
+    }
+
+    // Whitespace as the tokenizer sees it, including stray '\r's
+    bool isBlank(std::string_view line)
+    {
+        return std::all_of( line.begin(), line.end(), lexical::isWhitespace );
+    }
+}
+
+// What processing reads. Published snapshots are never modified; writers
+// change a copy and publish that.
+struct Processor::Snapshot
+{
+    std::vector<DescriptorMapPtr> descriptor_maps;
+    CommandMap commands;
+
+    Snapshot() = default;
+    Snapshot(const Snapshot&);
+
+    // To the last map, which is created, if there are the built-in ones only
+    void attach(const CommandDescriptorPtr&);
+};
+
+// The descriptor maps are copied, not shared, as writers attach to them.
+// The descriptors themselves are shared.
+Processor::Snapshot::Snapshot(const Snapshot& other)
+: commands{other.commands}
+{
+    descriptor_maps.reserve( other.descriptor_maps.size() );
+    for( auto& map : other.descriptor_maps )
+        descriptor_maps.push_back( std::make_shared<DescriptorMap>( *map ) );
+}
+
+void Processor::Snapshot::attach(const CommandDescriptorPtr& descriptor)
+{
+    if ( descriptor_maps.size() < 2 )
+        descriptor_maps.push_back( DescriptorMap::Create("Commands") );
+    descriptor_maps.back()->attach( descriptor );
+    commands.attach( descriptor );
+}
+
+// Writers change 'pending' and publish a copy of it. Until the processor
+// is read for the first time, publishing is left to the first reader, so
+// configuring a processor costs a single copy.
+struct Processor::State
+{
+    EpochDomain                   epoch;
+    std::atomic<const Snapshot*>  published{nullptr};
+    std::atomic<bool>             dirty{true};   // pending hasn't been published
+    std::atomic<bool>             live{false};   // has been read
+    std::mutex                    mutex;         // serializes writers
+    Snapshot                      pending;
+
+    ExecutorPtr                   executor;      // guarded by mutex
+    std::vector<ExecutorPtr>      replaced_executors;
+    std::mutex                    submit_mutex;
+    std::condition_variable       submitted_done;
+    long                          submitted{0};  // not yet completed
+
+    ~State()
+    {
+        delete published.load();
+    }
+
+    // Returns the replaced snapshot, which is to be retired (mutex held)
+    const Snapshot* publish()
+    {
+        auto snapshot{ std::make_unique<const Snapshot>( pending ) };
+        const Snapshot* replaced{ published.exchange( snapshot.release() ) };
+        dirty = false;
+        return replaced;
+    }
+};
+
+template <class FUNCTION>
+auto Processor::read(FUNCTION function) const
+{
+    if ( state->dirty.load() )
+        publish();
+    const auto guard{ state->epoch.pin() };
+    const Snapshot& snapshot{ *state->published.load() };
+    if ( !state->live.load(std::memory_order_relaxed) )
+        state->live.store(true);
+    return function( snapshot );
+}
+
+template <class FUNCTION>
+void Processor::update(FUNCTION function)
+{
+    const Snapshot* replaced{ nullptr };
+    {
+        std::lock_guard<std::mutex> lock( state->mutex );
+        try
+        {
+            function( state->pending );
+        }
+        catch(...)
+        {
+            // Publish what has been changed nevertheless
+            state->dirty = true;
+            throw;
+        }
+        if ( state->live.load() )
+            replaced = state->publish();
+        else
+            state->dirty = true;
+    }
+    if ( replaced )
+        state->epoch.retire( replaced );
+}
+
+void Processor::publish() const
+{
+    const Snapshot* replaced{ nullptr };
+    {
+        std::lock_guard<std::mutex> lock( state->mutex );
+        if ( state->dirty.load() )
+            replaced = state->publish();
+    }
+    if ( replaced )
+        state->epoch.retire( replaced );
+}
+
+//-----------------------------------------------------------------------------
+
 Processor::Processor( std::shared_ptr<Parser> p )
 : parser{p}
+, state{ std::make_unique<State>() }
 {
     auto builtin_descriptors{ DescriptorMap::Create("Built-In Commands") };
-    descriptor_maps.push_back( builtin_descriptors );
+    state->pending.descriptor_maps.push_back( builtin_descriptors );
     addHelpCommand();
     addExitCommand();
 }
 
+Processor::~Processor()
+{
+    drain();
+}
+
 void Processor::addExitCommand()
 {
-    auto builtin_descriptors{ descriptor_maps[0] };
     auto exit_descriptor{ ExitDescriptor::Create() };
-    builtin_descriptors->attach( exit_descriptor );
     auto exit_command{ Command::Create<ExitCommand>() };
-    commands.attach( exit_descriptor->getName(), exit_command );
+    update( [&](Snapshot& snapshot) {
+        snapshot.descriptor_maps[0]->attach( exit_descriptor );
+        snapshot.commands.attach( exit_descriptor );
+        snapshot.commands.attach( exit_descriptor->getName(), exit_command );
+    });
 }
 
 void Processor::addHelpCommand()
 {
-    auto builtin_descriptors{ descriptor_maps[0] };
     auto help_descriptor{ HelpDescriptor::Create() };
-    builtin_descriptors->attach( help_descriptor );
-    auto help_command{ std::make_shared<HelpCommand>( descriptor_maps ) };
-    commands.attach( help_descriptor->getName(), help_command );
+    auto help_command{ std::make_shared<HelpCommand>( [this]{
+        return read( [](const Snapshot& snapshot) {
+            return snapshot.descriptor_maps;
+        });
+    })};
+    update( [&](Snapshot& snapshot) {
+        snapshot.descriptor_maps[0]->attach( help_descriptor );
+        snapshot.commands.attach( help_descriptor );
+        snapshot.commands.attach( help_descriptor->getName(), help_command );
+    });
 }
 
 
 void Processor::attach(CommandDescriptorPtr p)
 {
-    if ( descriptor_maps.size() < 2 )
-        descriptor_maps.push_back( DescriptorMap::Create("Commands") );
-    descriptor_maps.back()->attach(p);
+    update( [&](Snapshot& snapshot) {
+        snapshot.attach(p);
+    });
+}
+
+void Processor::attach(const CommandDescriptors& descriptors)
+{
+    update( [&](Snapshot& snapshot) {
+        auto& maps{ snapshot.descriptor_maps };
+        if ( maps.size() < 2 )
+            maps.push_back( DescriptorMap::Create("Commands") );
+        maps.back()->attach(descriptors);
+        for( auto& descriptor : descriptors )
+            snapshot.commands.attach(descriptor);
+    });
 }
 
+// Both in one snapshot, so no reader sees the descriptor without command
 void Processor::attach(CommandDescriptorPtr desc, CommandPtr cmd )
 {
-    attach(desc);
-    attach(desc->getName(), cmd);
+    update( [&](Snapshot& snapshot) {
+        snapshot.attach(desc);
+        snapshot.commands.attach(desc->getName(), cmd);
+    });
+}
+
+CommandPtr Processor::wrap(std::function<void(const CommandLine&)> function)
+{
+    return Command::Create<CommandWrapper>(function);
 }
 
-void Processor::attach(
-    CommandDescriptorPtr desc, 
-    std::function<void(const CommandLine&)> cmd )
+CommandPtr Processor::wrap(std::function<void(const CommandLineView&)> function)
 {
-    attach( desc );
-    attach( desc->getName(), cmd );
+    return Command::Create<CommandWrapper>(function);
 }
 
 void Processor::attach(const std::string& name, CommandPtr ptr)
 {
-    commands.attach(name,ptr);
+    update( [&](Snapshot& snapshot) {
+        snapshot.commands.attach(name,ptr);
+    });
+}
+
+void Processor::attachAsync(CommandDescriptorPtr desc, AsyncFunction function)
+{
+    attach( desc, Command::Create<AsyncCommandWrapper>(function) );
+}
+
+void Processor::attachAsync(const std::string& name, AsyncFunction function)
+{
+    attach(name, Command::Create<AsyncCommandWrapper>(function));
 }
 
-void Processor::attach(
-    const std::string& name, 
-    std::function<void(const CommandLine&)> function)
+void Processor::detach(const std::string& name, CommandPtr ptr)
 {
-    commands.attach(name, Command::Create<CommandWrapper>(function));
+    update( [&](Snapshot& snapshot) {
+        snapshot.commands.detach(name,ptr);
+    });
 }
 
 void Processor::process(const std::string& input) const
 {
-    CommandLine cmdline = parser->parse( input );
-    for( auto map : descriptor_maps )
+    const auto diagnostic{ tryProcess( input ) };
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
+}
+
+Diagnostic Processor::tryProcess(std::string_view input) const
+{
+    return tryProcessWith( input, 
+        [](const Snapshot& snapshot, const CommandMap::Entry& entry, const auto& cmdline) {
+            snapshot.commands.invoke( entry, cmdline );
+        });
+}
+
+void Processor::process(const std::string& input, std::pmr::memory_resource* resource) const
+{
+    const auto diagnostic{ tryProcess( input, resource ) };
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
+}
+
+Diagnostic Processor::tryProcess(std::string_view input, std::pmr::memory_resource* resource) const
+{
+    if ( !resource )
+        throw NullptrAssignmentException("Processor::tryProcess(): memory resource");
+    auto invoke{ 
+        [](const Snapshot& snapshot, const CommandMap::Entry& entry, const auto& cmdline) {
+            snapshot.commands.invoke( entry, cmdline );
+        }};
+    if ( parser->providesViews() )
     {
-        if ( map->validate( cmdline ) )
+        CommandLineView cmdline( resource );
+        return tryProcessIn( input, cmdline, invoke );
+    }
+    CommandLine cmdline( resource );
+    return tryProcessIn( input, cmdline, invoke );
+}
+
+template <class FUNCTION>
+Diagnostic Processor::tryProcessWith(std::string_view input, FUNCTION function) const
+{
+    // The buffers of the thread are reused, so similar lines don't allocate
+    if ( parser->providesViews() )
+    {
+        LocalPool<CommandLineView>::Lease cmdline;
+        return tryProcessIn( input, *cmdline, function );
+    }
+    LocalPool<CommandLine>::Lease cmdline;
+    return tryProcessIn( input, *cmdline, function );
+}
+
+template <class FUNCTION>
+Diagnostic Processor::tryProcessIn(
+    std::string_view input, 
+    CommandLineView& cmdline, 
+    FUNCTION function) const
+{
+    auto diagnostic{ parser->tryParse( input, cmdline ) };
+    if ( diagnostic.ok() )
+        diagnostic = tryRun( cmdline, function );
+    diagnostic.locate( input );
+    return diagnostic;
+}
+
+template <class FUNCTION>
+Diagnostic Processor::tryProcessIn(
+    std::string_view input, 
+    CommandLine& cmdline, 
+    FUNCTION function) const
+{
+    LocalPool<std::string>::Lease text;
+    try
+    {
+        text->assign( input );
+        parser->parse( *text, cmdline );
+    }
+    catch( const InputException& )
+    {
+        return Diagnostic::FromCurrentException();
+    }
+    auto diagnostic{ tryRun( cmdline, function ) };
+    // The tokens are owned by the command line
+    diagnostic.detach();
+    return diagnostic;
+}
+
+// Validating a view stores the typed values and matched options in it
+template <class COMMANDLINE, class FUNCTION>
+Diagnostic Processor::tryRun(COMMANDLINE& cmdline, FUNCTION function) const
+{
+    return read( [&](const Snapshot& snapshot) {
+        // A single lookup yields both, the descriptor and the commands.
+        auto entry{ snapshot.commands.find( cmdline ) };
+        auto result{ tryValidate( entry, cmdline ) };
+        if ( result.ok() )
+            function( snapshot, *entry, std::as_const(cmdline) );
+        return result;
+    });
+}
+
+void Processor::process(int argc, const char* const* argv) const
+{
+    const auto diagnostic{ tryProcess( argc, argv ) };
+    if ( !diagnostic.ok() )
+        diagnostic.raise();
+}
+
+Diagnostic Processor::tryProcess(int argc, const char* const* argv) const
+{
+    auto invoke{ 
+        [](const Snapshot& snapshot, const CommandMap::Entry& entry, const auto& cmdline) {
+            snapshot.commands.invoke( entry, cmdline );
+        }};
+    if ( parser->providesViews() )
+    {
+        LocalPool<CommandLineView>::Lease cmdline;
+        auto diagnostic{ parser->tryParse( argc, argv, *cmdline ) };
+        if ( diagnostic.ok() )
+            diagnostic = tryRun( *cmdline, invoke );
+        return diagnostic;
+    }
+    LocalPool<CommandLine>::Lease cmdline;
+    try
+    {
+        *cmdline = parser->parse( argc, argv );
+    }
+    catch( const InputException& )
+    {
+        return Diagnostic::FromCurrentException();
+    }
+    auto diagnostic{ tryRun( *cmdline, invoke ) };
+    diagnostic.detach();
+    return diagnostic;
+}
+
+std::future<Diagnostic> Processor::submit(std::string line, Ordering ordering)
+{
+    auto promise{ std::make_shared<std::promise<Diagnostic>>() };
+    auto future{ promise->get_future() };
+    submit( std::move(line), 
+        [promise](const Diagnostic& diagnostic, std::exception_ptr exception) {
+            if ( exception )
+                promise->set_exception( exception );
+            else
+                promise->set_value( diagnostic );
+        }, ordering );
+    return future;
+}
+
+void Processor::submit(std::string line, Completion completion, Ordering ordering)
+{
+    std::string command;
+    if ( ordering == Ordering::PerCommand )
+    {
+        // An invalid line isn't ordered; it is only rejected.
+        if ( parser->providesViews() )
+        {
+            LocalPool<CommandLineView>::Lease cmdline;
+            if ( parser->tryParse( line, *cmdline ).ok() )
+                command = cmdline->getCommand();
+        }
+        else
+        {
+            try
+            {
+                LocalPool<CommandLine>::Lease cmdline;
+                parser->parse( line, *cmdline );
+                command = cmdline->getCommand();
+            }
+            catch( const InputException& )
+            {
+            }
+        }
+    }
+
+    auto executor{ getExecutor() };
+    auto finished{ [this] {
+        std::lock_guard<std::mutex> lock( state->submit_mutex );
+        if ( --state->submitted == 0 )
+            state->submitted_done.notify_all();
+    }};
+    {
+        std::lock_guard<std::mutex> lock( state->submit_mutex );
+        state->submitted++;
+    }
+    // 'done' lets the next line for the command go, if the line is ordered
+    auto job{ [this, line = std::move(line), completion = std::move(completion), 
+            executor = executor.get(), finished](Executor::Task done) mutable {
+        processSubmitted( line, *executor, 
+            [completion = std::move(completion), done = std::move(done), finished]
+            (const Diagnostic& diagnostic, std::exception_ptr exception) {
+                try
+                {
+                    completion( diagnostic, exception );
+                }
+                catch(...)
+                {
+                    // Nobody to report to
+                }
+                if ( done )
+                    done();
+                // The processor may be destroyed right after this
+                finished();
+            });
+    }};
+    try
+    {
+        if ( command.empty() )
+            executor->post( [job = std::move(job)]() mutable { job( nullptr ); } );
+        else
+            executor->post( command, Executor::Job( std::move(job) ) );
+    }
+    catch(...)
+    {
+        finished();
+        throw;
+    }
+}
+
+// Synchronous commands are invoked right away. If there is an AsyncCommand
+// among them, all of them are invoked by a coroutine, which continues on 
+// the executor and completes the line.
+void Processor::processSubmitted(
+    const std::string& line, 
+    Executor& executor, 
+    Completion completion) const
+{
+    Diagnostic diagnostic;
+    std::optional<AsyncTask> commands;
+    try
+    {
+        diagnostic = tryProcessWith( line, 
+            [&](const Snapshot& snapshot, const CommandMap::Entry& entry, const auto& cmdline) {
+                if ( std::none_of( entry.commands.begin(), entry.commands.end(), isAsync ) )
+                    snapshot.commands.invoke( entry, cmdline );
+                else
+                    commands.emplace( invokeAll( entry.commands, CommandLine(cmdline) ) );
+            });
+        diagnostic.detach();
+    }
+    catch(...)
+    {
+        completion( Diagnostic(), std::current_exception() );
+        return;
+    }
+    if ( !commands )
+    {
+        completion( diagnostic, nullptr );
+        return;
+    }
+    commands->start( &executor, 
+        [diagnostic, completion = std::move(completion)](std::exception_ptr exception) {
+            completion( diagnostic, exception );
+        });
+}
+
+void Processor::drain() const
+{
+    std::unique_lock<std::mutex> lock( state->submit_mutex );
+    state->submitted_done.wait( lock, [this]{ return state->submitted == 0; } );
+}
+
+void Processor::setExecutor(ExecutorPtr executor)
+{
+    if ( !executor )
+        throw NullptrAssignmentException("Processor::setExecutor()");
+    std::lock_guard<std::mutex> lock( state->mutex );
+    if ( state->executor )
+        state->replaced_executors.push_back( state->executor );
+    state->executor = executor;
+}
+
+ExecutorPtr Processor::getExecutor() const
+{
+    std::lock_guard<std::mutex> lock( state->mutex );
+    if ( !state->executor )
+        state->executor = Executor::Create();
+    return state->executor;
+}
+
+template <class COMMANDLINE>
+Diagnostic Processor::tryValidate(const CommandMap::Entry* entry, COMMANDLINE& cmdline) const
+{
+    if ( !entry || !entry->descriptor )
+        return Diagnostic( ErrorCode::InvalidCommand, cmdline.getCommandText() );
+    auto diagnostic{ entry->descriptor->tryValidate( cmdline ) };
+    if ( diagnostic.ok() && entry->commands.empty() )
+        return Diagnostic( ErrorCode::CommandNotFound, cmdline.getCommandText() );
+    return diagnostic;
+}
+
+
+std::vector<LineStatus> Processor::processBatch(std::span<const std::string_view> lines) const
+{
+    return read( [&](const Snapshot& snapshot) {
+        std::vector<LineStatus> status;
+        status.reserve( lines.size() );
+        CachedLookup lookup( snapshot.commands );
+        if ( parser->providesViews() )
+        {
+            CommandLineView cmdline; // keeps its capacity from line to line
+            for( auto line : lines )
+            {
+                if ( !parser->tryParse( line, cmdline ).ok() )
+                {
+                    status.push_back( LineStatus::InvalidSyntax );
+                    continue;
+                }
+                status.push_back( dispatchLine( 
+                    snapshot, lookup.find( cmdline ), cmdline ) );
+            }
+        }
+        else
+        {
+            std::string text;
+            CommandLine cmdline;
+            for( auto line : lines )
+            {
+                try
+                {
+                    text.assign( line );
+                    parser->parse( text, cmdline );
+                }
+                catch( const InputException& )
+                {
+                    status.push_back( LineStatus::InvalidSyntax );
+                    continue;
+                }
+                status.push_back( dispatchLine( 
+                    snapshot, lookup.find( cmdline ), std::as_const(cmdline) ) );
+            }
+        }
+        return status;
+    });
+}
+
+// Three stages connected by rings of item indices: a thread parses, another
+// one looks up and validates, and the calling thread invokes the commands.
+// A fourth ring returns the items to the parsing thread. As there are only
+// PipelineDepth items, pushing never fails; the parsing thread waits for a
+// free item instead, which holds it back while the commands are slower.
+// A stage, that waits, spins for a little while and then sleeps.
+std::vector<LineStatus> Processor::processPipelined(std::span<const std::string_view> lines) const
+{
+    if ( !parser->providesViews() || lines.size() < PipelineMinimum )
+        return processBatch( lines );
+    return read( [&](const Snapshot& snapshot) {
+        std::vector<PipelineItem> items( PipelineDepth );
+        SpscRing<std::uint32_t> free( PipelineDepth );
+        SpscRing<std::uint32_t> parsed( PipelineDepth );
+        SpscRing<std::uint32_t> validated( PipelineDepth );
+        for( std::uint32_t index{0}; index < PipelineDepth; index++ )
+            free.tryPush( index );
+
+        std::exception_ptr failures[2];     // of the parsing and validating thread
+        // Waiting stages wake up, and their pop() fails
+        auto abort{ [&]{
+            free.close();
+            parsed.close();
+            validated.close();
+        }};
+        auto stage{ [&abort](std::exception_ptr& failure, auto body) {
+            return std::thread( [&abort, &failure, body]{
+                try
+                {
+                    body();
+                }
+                catch(...)
+                {
+                    failure = std::current_exception();
+                    abort();
+                }
+            });
+        }};
+
+        std::thread parsing;
+        std::thread validating;
+        auto stop{ [&]{
+            if ( parsing.joinable() )
+                parsing.join();
+            if ( validating.joinable() )
+                validating.join();
+        }};
+
+        std::vector<LineStatus> status;
+        try
+        {
+            status.reserve( lines.size() );
+            parsing = stage( failures[0], [&]{
+                std::uint32_t index;
+                for( auto line : lines )
+                {
+                    if ( !free.pop( index ) )
+                        return;
+                    auto& item{ items[index] };
+                    item.status = parser->tryParse( line, item.cmdline ).ok()
+                        ? LineStatus::Processed
+                        : LineStatus::InvalidSyntax;
+                    parsed.tryPush( index );
+                }
+            });
+            validating = stage( failures[1], [&]{
+                CachedLookup lookup( snapshot.commands );
+                std::uint32_t index;
+                for( std::size_t n{0}; n < lines.size(); n++ )
+                {
+                    if ( !parsed.pop( index ) )
+                        return;
+                    auto& item{ items[index] };
+                    if ( item.status == LineStatus::Processed )
+                    {
+                        item.entry = lookup.find( item.cmdline );
+                        item.status = validateLine( item.entry, item.cmdline );
+                    }
+                    validated.tryPush( index );
+                }
+            });
+            std::uint32_t index;
+            for( std::size_t n{0}; n < lines.size() && validated.pop( index ); n++ )
+            {
+                auto& item{ items[index] };
+                if ( item.status == LineStatus::Processed )
+                    item.status = invokeLine( snapshot, *item.entry, item.cmdline );
+                status.push_back( item.status );
+                free.tryPush( index );
+            }
+        }
+        catch(...)
         {
-            commands.invoke( cmdline );
-            return;
+            abort();
+            stop();
+            throw;
         }
+        stop();
+        for( auto& failure : failures )
+            if ( failure )
+                std::rethrow_exception( failure );
+        return status;
+    });
+}
+
+// The lines are found with memchr(), which scans 16 or 32 bytes at a time
+// in common C libraries. Each one is parsed right in the mapping.
+RunStats Processor::runFile(const std::string& path, ErrorPolicy policy) const
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start{ Clock::now() };
+    const MappedFile file( path );
+    const std::string_view script{ file.getContents() };
+    RunStats stats;
+    stats.bytes = script.size();
+
+    read( [&](const Snapshot& snapshot) {
+        CachedLookup lookup( snapshot.commands );
+        CommandLineView view;   // keep their capacity from line to line
+        std::string text;
+        CommandLine cmdline;
+        bool failed;
+        // Validating a view stores the typed values in it
+        auto execute{ [&](auto& cmdline) {
+            const auto entry{ lookup.find( cmdline ) };
+            auto diagnostic{ tryValidate( entry, cmdline ) };
+            if ( diagnostic.ok() )
+            {
+                try
+                {
+                    snapshot.commands.invoke( *entry, std::as_const(cmdline) );
+                }
+                catch(...)
+                {
+                    failed = true;
+                    return Diagnostic::FromCurrentException();
+                }
+            }
+            return diagnostic;
+        }};
+
+        const char* position{ script.data() };
+        const char* const end{ position + script.size() };
+        while( position != end )
+        {
+            const auto newline{ static_cast<const char*>( 
+                std::memchr( position, '\n', end - position ) ) };
+            std::string_view line( position, ( newline ? newline : end ) - position );
+            position = newline ? newline + 1 : end;
+            stats.lines++;
+            if ( !line.empty() && line.back() == '\r' )
+                line.remove_suffix(1);
+            if ( isBlank(line) )
+            {
+                stats.blank++;
+                continue;
+            }
+
+            Diagnostic diagnostic;
+            failed = false;
+            if ( parser->providesViews() )
+            {
+                diagnostic = parser->tryParse( line, view );
+                if ( diagnostic.ok() )
+                    diagnostic = execute( view );
+            }
+            else
+            {
+                try
+                {
+                    text.assign( line );
+                    parser->parse( text, cmdline );
+                }
+                catch( const InputException& )
+                {
+                    diagnostic = Diagnostic::FromCurrentException();
+                }
+                if ( diagnostic.ok() )
+                    diagnostic = execute( cmdline );
+            }
+            if ( diagnostic.ok() )
+            {
+                stats.processed++;
+                continue;
+            }
+            ( failed ? stats.failed : stats.rejected )++;
+            if ( !stats.error_line )
+            {
+                // The mapping is about to go
+                diagnostic.locate( line );
+                diagnostic.detach();
+                stats.error_line = stats.lines;
+                stats.error_input = line;
+                stats.error = diagnostic;
+            }
+            if ( policy == ErrorPolicy::Stop )
+            {
+                stats.stopped = true;
+                break;
+            }
+        }
+    });
+
+    const std::chrono::duration<double> elapsed{ Clock::now() - start };
+    stats.seconds = elapsed.count();
+    return stats;
+}
+
+template <class COMMANDLINE>
+LineStatus Processor::dispatchLine(
+    const Snapshot& snapshot,
+    const CommandMap::Entry* entry,
+    COMMANDLINE& cmdline) const
+{
+    const auto status{ validateLine( entry, cmdline ) };
+    if ( status != LineStatus::Processed )
+        return status;
+    return invokeLine( snapshot, *entry, cmdline );
+}
+
+template <class COMMANDLINE>
+LineStatus Processor::validateLine(const CommandMap::Entry* entry, COMMANDLINE& cmdline) const
+{
+    if ( !entry || !entry->descriptor || entry->commands.empty() )
+        return LineStatus::InvalidCommand;
+    switch( tryValidate( entry, cmdline ).getCode() )
+    {
+        case ErrorCode::None:
+            return LineStatus::Processed;
+        case ErrorCode::InvalidCommand:
+        case ErrorCode::CommandNotFound:
+            return LineStatus::InvalidCommand;
+        default:
+            return LineStatus::InvalidArguments;
+    }
+}
+
+template <class COMMANDLINE>
+LineStatus Processor::invokeLine(
+    const Snapshot& snapshot,
+    const CommandMap::Entry& entry,
+    COMMANDLINE& cmdline) const
+{
+    try
+    {
+        snapshot.commands.invoke( entry, cmdline );
+    }
+    catch(...)
+    {
+        // Whatever it throws, the line failed and the next one goes
+        return LineStatus::CommandFailed;
     }
-    throw InvalidCommandException( cmdline.getCommand() );
+    return LineStatus::Processed;
 }
 
+std::ostream& operator<<(std::ostream& os, const elrat::clp::RunStats& stats)
+{
+    os << "Lines..............: " << stats.lines << "\n"
+        << "-> Blank..........: " << stats.blank << "\n"
+        << "-> Processed......: " << stats.processed << "\n"
+        << "-> Rejected.......: " << stats.rejected << "\n"
+        << "-> Failed.........: " << stats.failed << "\n"
+        << "Bytes..............: " << stats.bytes << "\n"
+        << "Seconds............: " << stats.seconds << "\n";
+    if ( stats.error_line )
+        os << "First error........: line " << stats.error_line 
+            << ( stats.stopped ? " (stopped)" : "" ) << ": " 
+            << stats.error.getMessage() << "\n";
+    return os;
+}
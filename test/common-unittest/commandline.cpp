@@ -0,0 +1,234 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "elrat/clp/commandline.hpp"
+#include "elrat/clp/commandlineview.hpp"
+#include "elrat/clp/smallvector.hpp"
+
+namespace clp = elrat::clp;
+
+BOOST_AUTO_TEST_SUITE( SmallVectorTestSuite )
+
+    BOOST_AUTO_TEST_CASE( InlineAndHeap )
+    {
+        clp::SmallVector<int,4> v;
+        BOOST_CHECK( v.empty() );
+        BOOST_CHECK_EQUAL( v.capacity(), 4 );
+        const int* local{ v.data() };
+        for( int i{0}; i < 4; i++ )
+            v.push_back(i);
+        BOOST_CHECK_EQUAL( v.data(), local );
+        v.push_back(4);
+        BOOST_CHECK( v.data() != local );
+        BOOST_CHECK_GE( v.capacity(), 5 );
+        BOOST_REQUIRE_EQUAL( v.size(), 5 );
+        for( int i{0}; i < 5; i++ )
+            BOOST_CHECK_EQUAL( v[i], i );
+
+        // clear() keeps the allocation
+        const auto capacity{ v.capacity() };
+        v.clear();
+        BOOST_CHECK( v.empty() );
+        BOOST_CHECK_EQUAL( v.capacity(), capacity );
+    }
+
+    // Appending its own elements survives the reallocation
+    BOOST_AUTO_TEST_CASE( AppendOwnElements )
+    {
+        clp::SmallVector<char,4> v;
+        v.append( "abc", 3 );
+        v.append( v.data(), v.size() );
+        v.push_back( v[0] );
+        BOOST_CHECK_EQUAL( std::string_view( v.data(), v.size() ), "abcabca" );
+    }
+
+    BOOST_AUTO_TEST_CASE( CopyAndMove )
+    {
+        clp::SmallVector<int,2> small, large;
+        small.push_back(1);
+        for( int i{0}; i < 3; i++ )
+            large.push_back(i);
+
+        auto small_copy{ small };
+        auto large_copy{ large };
+        BOOST_CHECK( std::ranges::equal( small_copy, small ) );
+        BOOST_CHECK( std::ranges::equal( large_copy, large ) );
+
+        const int* heap{ large.data() };
+        auto moved{ std::move(large) };
+        BOOST_CHECK_EQUAL( moved.data(), heap );
+        BOOST_CHECK( large.empty() );
+        moved = std::move(small);
+        BOOST_REQUIRE_EQUAL( moved.size(), 1 );
+        BOOST_CHECK_EQUAL( moved[0], 1 );
+    }
+
+    // Moving between resources copies, as the allocation can't change hands
+    BOOST_AUTO_TEST_CASE( MemoryResources )
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        clp::SmallVector<int,2> v( &arena ), w;
+        BOOST_CHECK_EQUAL( v.resource(), &arena );
+        BOOST_CHECK_EQUAL( w.resource(), std::pmr::get_default_resource() );
+        for( int i{0}; i < 3; i++ )
+            v.push_back(i);
+        const int* allocated{ v.data() };
+        w = std::move(v);
+        BOOST_CHECK( w.data() != allocated );
+        BOOST_CHECK_EQUAL( w.resource(), std::pmr::get_default_resource() );
+        BOOST_CHECK_EQUAL( w.size(), 3 );
+        BOOST_CHECK( v.empty() );
+
+        // A moved vector keeps the resource
+        clp::SmallVector<int,2> u( &arena );
+        u.append( w.data(), w.size() );
+        allocated = u.data();
+        auto moved{ std::move(u) };
+        BOOST_CHECK_EQUAL( moved.data(), allocated );
+        BOOST_CHECK_EQUAL( moved.resource(), &arena );
+
+        clp::CommandLine cmdline( &arena );
+        BOOST_CHECK_EQUAL( cmdline.getMemoryResource(), &arena );
+        BOOST_CHECK_EQUAL( clp::CommandLine( cmdline ).getMemoryResource(), 
+            std::pmr::get_default_resource() );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( CommandLineTestSuite )
+
+    clp::CommandLine makeCommandLine()
+    {
+        clp::CommandLine cmdline;
+        cmdline.setCommand("copy");
+        cmdline.addCommandParameter("from");
+        cmdline.addCommandParameter("to");
+        cmdline.addOption("force");
+        cmdline.addOption("level");
+        cmdline.addOptionParameter("3");
+        cmdline.addOptionParameter("4");
+        return cmdline;
+    }
+
+    BOOST_AUTO_TEST_CASE( Accessors )
+    {
+        const auto cmdline{ makeCommandLine() };
+        BOOST_CHECK( cmdline );
+        BOOST_CHECK_EQUAL( cmdline.getCommand(), "copy" );
+        const std::vector<std::string_view> parameters{ "from", "to" };
+        BOOST_CHECK( std::ranges::equal( cmdline.getCommandParameters(), parameters ) );
+        BOOST_CHECK_EQUAL( cmdline.getCommandParameter(1), "to" );
+        BOOST_CHECK_THROW( cmdline.getCommandParameter(2), std::out_of_range );
+
+        BOOST_CHECK_EQUAL( cmdline.getOptionCount(), 2 );
+        BOOST_CHECK( cmdline.optionExists("force") );
+        BOOST_CHECK( !cmdline.optionExists("forc") );
+        BOOST_CHECK_EQUAL( cmdline.getOption(1), "level" );
+        BOOST_CHECK( cmdline.getOptionParameters("force").empty() );
+        BOOST_REQUIRE_EQUAL( cmdline.getOptionParameters("level").size(), 2 );
+        BOOST_CHECK_EQUAL( cmdline.getOptionParameters(1)[1], "4" );
+        BOOST_CHECK_EQUAL( cmdline.getOptionParameterAs<int>("level", 0), 3 );
+        BOOST_CHECK_THROW( cmdline.getOptionParameters("verbose"), std::invalid_argument );
+        BOOST_CHECK_THROW( cmdline.getOption(2), std::out_of_range );
+    }
+
+    std::size_t length(const std::string& s)
+    {
+        return s.size();
+    }
+
+    // Code written for the accessors, that returned std::strings and
+    // std::vector<std::string>s, still compiles
+    BOOST_AUTO_TEST_CASE( StringAccessors )
+    {
+        const auto cmdline{ makeCommandLine() };
+        const std::string command = cmdline.getCommand();
+        const std::string& option{ cmdline.getOption(1) };
+        std::string parameter;
+        parameter = cmdline.getCommandParameter(0);
+        BOOST_CHECK_EQUAL( command, "copy" );
+        BOOST_CHECK_EQUAL( option, "level" );
+        BOOST_CHECK_EQUAL( parameter, "from" );
+        BOOST_CHECK_EQUAL( length( cmdline.getCommand() ), 4 );
+        BOOST_CHECK_EQUAL( cmdline.getCommand() + std::string("x"), "copyx" );
+        auto appended{ cmdline.getCommand() };
+        appended += "x";
+        BOOST_CHECK_EQUAL( appended, "copyx" );
+
+        const clp::CommandLine::Parameters parameters = cmdline.getCommandParameters();
+        const std::vector<std::string>& level{ cmdline.getOptionParameters("level") };
+        BOOST_CHECK( parameters == std::vector<std::string>({ "from", "to" }) );
+        BOOST_CHECK( level == std::vector<std::string>({ "3", "4" }) );
+        auto extended{ cmdline.getCommandParameters() };
+        extended.push_back("more");
+        BOOST_CHECK_EQUAL( extended.size(), 3 );
+        std::string joined;
+        for( auto& p : cmdline.getCommandParameters() )
+            joined += p;
+        BOOST_CHECK_EQUAL( joined, "fromto" );
+    }
+
+    // The *Text accessors refer to the buffer of the command line
+    BOOST_AUTO_TEST_CASE( TextAccessors )
+    {
+        const auto cmdline{ makeCommandLine() };
+        const std::string_view command{ cmdline.getCommandText() };
+        BOOST_CHECK_EQUAL( command, "copy" );
+        BOOST_CHECK_EQUAL( cmdline.getOptionText(1), "level" );
+        BOOST_CHECK_EQUAL( cmdline.getCommandParameterText(1), "to" );
+        BOOST_CHECK_EQUAL( cmdline.getCommandParameterText(1).data(), 
+            cmdline.getCommandParameterTexts()[1].data() );
+        const std::vector<std::string_view> level{ "3", "4" };
+        BOOST_CHECK( std::ranges::equal( cmdline.getOptionParameterTexts("level"), level ) );
+        BOOST_CHECK( std::ranges::equal( cmdline.getOptionParameterTexts(1), level ) );
+        BOOST_CHECK_THROW( cmdline.getCommandParameterText(2), std::out_of_range );
+        BOOST_CHECK_THROW( cmdline.getOptionText(2), std::out_of_range );
+
+        const clp::CommandLineView view( cmdline );
+        BOOST_CHECK_EQUAL( view.getCommandText().data(), command.data() );
+        BOOST_CHECK( std::ranges::equal( view.getOptionParameterTexts("level"), level ) );
+    }
+
+    // Copies don't refer to the original's buffer
+    BOOST_AUTO_TEST_CASE( CopyAndClear )
+    {
+        auto original{ makeCommandLine() };
+        const auto copy{ original };
+        original.clear();
+        BOOST_CHECK( !original );
+        BOOST_CHECK_EQUAL( original.getOptionCount(), 0 );
+        BOOST_CHECK( original.getCommandParameters().empty() );
+        original.setCommand("move");
+        BOOST_CHECK_EQUAL( original.getCommand(), "move" );
+        BOOST_CHECK_EQUAL( copy.getCommand(), "copy" );
+        BOOST_CHECK_EQUAL( copy.getOptionParameters("level")[0], "3" );
+
+        // Tokens of the command line itself may be added again
+        auto cmdline{ makeCommandLine() };
+        for( int i{0}; i < 20; i++ )
+            cmdline.addCommandParameter( cmdline.getCommandParameter(i) );
+        BOOST_CHECK_EQUAL( cmdline.getCommandParameter(21), "to" );
+    }
+
+    BOOST_AUTO_TEST_CASE( FromView )
+    {
+        const auto cmdline{ makeCommandLine() };
+        const clp::CommandLineView view( cmdline );
+        const clp::CommandLine copy( view );
+        BOOST_CHECK_EQUAL( copy.getCommand(), "copy" );
+        BOOST_CHECK( std::ranges::equal(
+            copy.getCommandParameters(), cmdline.getCommandParameters() ) );
+        BOOST_CHECK( std::ranges::equal(
+            copy.getOptionParameters("level"), cmdline.getOptionParameters("level") ) );
+        BOOST_CHECK_THROW( clp::CommandLine().addOptionParameter("x"), std::runtime_error );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/epoch.hpp"
+
+namespace
+{
+    // Objects, whose deletion is only recorded, so that a reader can check
+    // that it doesn't use a deleted one.
+    struct Object
+    {
+        std::atomic<bool> deleted{false};
+    };
+}
+
+BOOST_AUTO_TEST_SUITE( EpochTestSuite )
+
+    BOOST_AUTO_TEST_CASE( RetireWithoutReaders )
+    {
+        EpochDomain domain;
+        int deleted{0};
+        domain.retire( [&deleted]{ deleted++; } );
+        BOOST_CHECK_EQUAL( domain.reclaim(), 0 );
+        BOOST_CHECK_EQUAL( deleted, 1 );
+    }
+
+    BOOST_AUTO_TEST_CASE( PinnedReaderDefersDeletion )
+    {
+        EpochDomain domain;
+        int deleted{0};
+        {
+            auto guard{ domain.pin() };
+            domain.retire( [&deleted]{ deleted++; } );
+            BOOST_CHECK_EQUAL( domain.reclaim(), 1 );
+            BOOST_CHECK_EQUAL( deleted, 0 );
+            // Nested pins of the same thread
+            auto nested{ domain.pin() };
+            BOOST_CHECK_EQUAL( domain.reclaim(), 1 );
+        }
+        BOOST_CHECK_EQUAL( domain.reclaim(), 0 );
+        BOOST_CHECK_EQUAL( deleted, 1 );
+    }
+
+    BOOST_AUTO_TEST_CASE( ReadersOfLaterEpochsDontDefer )
+    {
+        EpochDomain domain;
+        int deleted{0};
+        domain.retire( [&deleted]{ deleted++; } );
+        auto guard{ domain.pin() };  // after the object has been replaced
+        domain.reclaim();
+        domain.retire( [&deleted]{ deleted++; } );
+        domain.reclaim();
+        BOOST_CHECK_EQUAL( deleted, 1 );
+    }
+
+    BOOST_AUTO_TEST_CASE( DestructorDeletesEverything )
+    {
+        int deleted{0};
+        {
+            EpochDomain domain;
+            {
+                auto guard{ domain.pin() };
+                domain.retire( [&deleted]{ deleted++; } );
+                domain.retire( [&deleted]{ deleted++; } );
+            }
+        }
+        BOOST_CHECK_EQUAL( deleted, 2 );
+    }
+
+    // Readers never see an object, that has been deleted, while writers
+    // keep replacing it.
+    BOOST_AUTO_TEST_CASE( ConcurrentReplacement )
+    {
+        const int ReaderCount{ 4 };
+        const int Replacements{ 20000 };
+        EpochDomain domain;
+        std::vector<std::unique_ptr<Object>> objects;
+        objects.reserve( Replacements + 1 );
+        for( int i{0}; i <= Replacements; i++ )
+            objects.push_back( std::make_unique<Object>() );
+        std::atomic<Object*> current{ objects[0].get() };
+        std::atomic<bool> done{false};
+        std::atomic<long> violations{0};
+
+        std::vector<std::thread> readers;
+        for( int r{0}; r < ReaderCount; r++ )
+            readers.emplace_back( [&]{
+                while( !done )
+                {
+                    auto guard{ domain.pin() };
+                    Object* object{ current.load() };
+                    for( int i{0}; i < 10; i++ )
+                        if ( object->deleted.load() )
+                            violations++;
+                }
+            });
+        for( int i{1}; i <= Replacements; i++ )
+        {
+            Object* replaced{ current.exchange( objects[i].get() ) };
+            domain.retire( [replaced]{ replaced->deleted = true; } );
+        }
+        done = true;
+        for( auto& reader : readers )
+            reader.join();
+        BOOST_CHECK_EQUAL( domain.reclaim(), 0 );
+        BOOST_CHECK_EQUAL( violations, 0 );
+        for( int i{0}; i < Replacements; i++ )
+            BOOST_CHECK( objects[i]->deleted );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "common/ringbuffer.hpp"
+
+BOOST_AUTO_TEST_SUITE( RingBufferTestSuite )
+
+    BOOST_AUTO_TEST_CASE( FullAndEmpty )
+    {
+        SpscRing<int> ring(3);
+        BOOST_CHECK_EQUAL( ring.capacity(), 4 );
+        int value;
+        BOOST_CHECK( !ring.tryPop(value) );
+        for( int i{0}; i < 4; i++ )
+            BOOST_CHECK( ring.tryPush(i) );
+        BOOST_CHECK( !ring.tryPush(4) );
+        BOOST_CHECK( ring.tryPop(value) );
+        BOOST_CHECK_EQUAL( value, 0 );
+        BOOST_CHECK( ring.tryPush(4) );
+        for( int i{1}; i <= 4; i++ )
+        {
+            BOOST_CHECK( ring.tryPop(value) );
+            BOOST_CHECK_EQUAL( value, i );
+        }
+        BOOST_CHECK( !ring.tryPop(value) );
+    }
+
+    // The consumer receives every value once, in order
+    BOOST_AUTO_TEST_CASE( ProducerAndConsumer )
+    {
+        const std::uint64_t count{ 1000000 };
+        SpscRing<std::uint64_t> ring(64);
+        std::thread producer( [&ring, count]{
+            for( std::uint64_t i{0}; i < count; i++ )
+                while( !ring.tryPush(i) )
+                    std::this_thread::yield();
+        });
+        std::uint64_t out_of_order{0};
+        for( std::uint64_t expected{0}; expected < count; expected++ )
+        {
+            std::uint64_t value;
+            while( !ring.tryPop(value) )
+                std::this_thread::yield();
+            if ( value != expected )
+                out_of_order++;
+        }
+        producer.join();
+        BOOST_CHECK_EQUAL( out_of_order, 0 );
+    }
+
+    // pop() sleeps, until the producer pushes, and fails once the ring
+    // has been closed and emptied
+    BOOST_AUTO_TEST_CASE( WaitAndClose )
+    {
+        const int count{ 200 };
+        SpscRing<int> ring(8);
+        std::thread producer( [&ring]{
+            for( int i{0}; i < count; i++ )
+            {
+                while( !ring.tryPush(i) )
+                    std::this_thread::yield();
+                if ( i % 50 == 0 )
+                    std::this_thread::sleep_for( std::chrono::milliseconds(2) );
+            }
+            ring.close();
+        });
+        int value;
+        int received{0};
+        while( ring.pop(value) )
+            BOOST_REQUIRE_EQUAL( value, received++ );
+        producer.join();
+        BOOST_CHECK_EQUAL( received, count );
+        BOOST_CHECK( !ring.pop(value) );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+
+#include "elrat/clp/stringmap.hpp"
+
+using elrat::clp::StringMap;
+
+BOOST_AUTO_TEST_SUITE( StringMapTestSuite )
+
+    BOOST_AUTO_TEST_CASE( Empty )
+    {
+        StringMap<int> map;
+        BOOST_CHECK( map.empty() );
+        BOOST_CHECK( map.find("x") == nullptr );
+        BOOST_CHECK( !map.erase("x") );
+        BOOST_CHECK( map.begin() == map.end() );
+    }
+
+    BOOST_AUTO_TEST_CASE( InsertAndFind )
+    {
+        StringMap<int> map;
+        BOOST_CHECK( map.insert("one", 1).second );
+        BOOST_CHECK( map.insert("two", 2).second );
+        BOOST_CHECK( map.insert("", 0).second );
+
+        auto existing{ map.insert("one", 11) };
+        BOOST_CHECK( !existing.second );
+        BOOST_CHECK_EQUAL( *existing.first, 1 );
+
+        BOOST_CHECK_EQUAL( map.size(), 3 );
+        BOOST_REQUIRE( map.find("two") );
+        BOOST_CHECK_EQUAL( *map.find("two"), 2 );
+        BOOST_CHECK( map.contains("") );
+        BOOST_CHECK( !map.contains("three") );
+        BOOST_CHECK( !map.contains("on") );
+    }
+
+    BOOST_AUTO_TEST_CASE( InsertionOrder )
+    {
+        StringMap<int> map;
+        for( int i{0}; i < 100; i++ )
+            map.insert( std::to_string(i), i );
+        int expected{0};
+        for( auto& entry : map )
+        {
+            BOOST_CHECK_EQUAL( entry.key, std::to_string(expected) );
+            BOOST_CHECK_EQUAL( entry.value, expected++ );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE( Clear )
+    {
+        StringMap<int> map;
+        map.insert("a", 1);
+        map.clear();
+        BOOST_CHECK( map.empty() );
+        BOOST_CHECK( !map.contains("a") );
+        BOOST_CHECK( map.insert("a", 2).second );
+        BOOST_CHECK_EQUAL( *map.find("a"), 2 );
+    }
+
+    // Random inserts and erases (few keys, so that probe sequences collide)
+    // compared with std::map
+    BOOST_AUTO_TEST_CASE( SameAsStdMap )
+    {
+        StringMap<int> map;
+        std::map<std::string,int> reference;
+        std::mt19937 random{42};
+        for( int i{0}; i < 100000; i++ )
+        {
+            const std::string key{ std::to_string( random() % 64 ) };
+            if ( random() % 2 )
+            {
+                BOOST_REQUIRE_EQUAL(
+                    map.insert(key, i).second,
+                    reference.emplace(key, i).second );
+            }
+            else
+            {
+                BOOST_REQUIRE_EQUAL( map.erase(key), reference.erase(key) == 1 );
+            }
+            BOOST_REQUIRE_EQUAL( map.size(), reference.size() );
+        }
+        for( int key{0}; key < 64; key++ )
+        {
+            auto found{ reference.find( std::to_string(key) ) };
+            auto value{ map.find( std::to_string(key) ) };
+            BOOST_REQUIRE_EQUAL( value != nullptr, found != reference.end() );
+            if ( value )
+                BOOST_CHECK_EQUAL( *value, found->second );
+        }
+        for( auto& entry : map )
+            BOOST_CHECK_EQUAL( reference.at(entry.key), entry.value );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,68 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+
+#include "elrat/clp/symbolmap.hpp"
+
+using elrat::clp::Symbol;
+using elrat::clp::SymbolMap;
+
+BOOST_AUTO_TEST_SUITE( SymbolMapTestSuite )
+
+    BOOST_AUTO_TEST_CASE( InsertAndFind )
+    {
+        SymbolMap<int> map;
+        BOOST_CHECK( map.empty() );
+        BOOST_CHECK( map.find(1) == nullptr );
+        BOOST_CHECK( !map.erase(1) );
+
+        BOOST_CHECK( map.insert(1, 10).second );
+        BOOST_CHECK( map.insert(1000000, 20).second );
+        auto existing{ map.insert(1, 11) };
+        BOOST_CHECK( !existing.second );
+        BOOST_CHECK_EQUAL( *existing.first, 10 );
+        BOOST_CHECK_EQUAL( map.size(), 2 );
+        BOOST_REQUIRE( map.find(1000000) );
+        BOOST_CHECK_EQUAL( *map.find(1000000), 20 );
+        BOOST_CHECK( !map.contains(2) );
+
+        map.clear();
+        BOOST_CHECK( map.empty() );
+        BOOST_CHECK( !map.contains(1) );
+    }
+
+    // Random inserts and erases (few keys, so that probe sequences collide)
+    // compared with std::map
+    BOOST_AUTO_TEST_CASE( SameAsStdMap )
+    {
+        SymbolMap<int> map;
+        std::map<Symbol,int> reference;
+        std::mt19937 random{42};
+        for( int i{0}; i < 100000; i++ )
+        {
+            const Symbol key{ 1 + static_cast<Symbol>( random() % 64 ) * 1024 };
+            if ( random() % 2 )
+            {
+                BOOST_REQUIRE_EQUAL(
+                    map.insert(key, i).second,
+                    reference.emplace(key, i).second );
+            }
+            else
+            {
+                BOOST_REQUIRE_EQUAL( map.erase(key), reference.erase(key) == 1 );
+            }
+            BOOST_REQUIRE_EQUAL( map.size(), reference.size() );
+        }
+        for( auto& [key, value] : reference )
+        {
+            BOOST_REQUIRE( map.find(key) );
+            BOOST_CHECK_EQUAL( *map.find(key), value );
+        }
+        for( auto& entry : map )
+            BOOST_CHECK_EQUAL( reference.at(entry.key), entry.value );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
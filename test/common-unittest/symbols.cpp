@@ -0,0 +1,109 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "elrat/clp/commandline.hpp"
+#include "elrat/clp/commandlineview.hpp"
+#include "elrat/clp/symbols.hpp"
+
+namespace clp = elrat::clp;
+
+BOOST_AUTO_TEST_SUITE( SymbolsTestSuite )
+
+    BOOST_AUTO_TEST_CASE( InternAndFind )
+    {
+        const auto symbol{ clp::Symbols::intern("symbols-test-copy") };
+        BOOST_CHECK( symbol != clp::NoSymbol );
+        BOOST_CHECK_EQUAL( clp::Symbols::intern("symbols-test-copy"), symbol );
+        BOOST_CHECK_EQUAL( clp::Symbols::find("symbols-test-copy"), symbol );
+        BOOST_CHECK_EQUAL( clp::Symbols::getName(symbol), "symbols-test-copy" );
+        BOOST_CHECK_EQUAL( clp::Symbols::find("symbols-test-unknown"), clp::NoSymbol );
+        BOOST_CHECK( clp::Symbols::getName(clp::NoSymbol).empty() );
+        BOOST_CHECK_THROW(
+            clp::Symbols::getName( clp::Symbols::size() + 1 ), std::out_of_range );
+    }
+
+    // The table grows, while the symbols remain
+    BOOST_AUTO_TEST_CASE( Growth )
+    {
+        std::vector<clp::Symbol> symbols;
+        for( int i{0}; i < 5000; i++ )
+            symbols.push_back( clp::Symbols::intern( "symbols-test-" + std::to_string(i) ) );
+        for( int i{0}; i < 5000; i++ )
+        {
+            const auto name{ "symbols-test-" + std::to_string(i) };
+            BOOST_REQUIRE_EQUAL( clp::Symbols::find(name), symbols[i] );
+            BOOST_REQUIRE_EQUAL( clp::Symbols::getName(symbols[i]), name );
+        }
+    }
+
+    // Readers find every name, that has been interned before, while a
+    // writer keeps interning.
+    BOOST_AUTO_TEST_CASE( ConcurrentLookups )
+    {
+        const int count{ 20000 };
+        std::atomic<int> interned{0};
+        std::thread writer( [&]{
+            for( int i{0}; i < count; i++ )
+            {
+                clp::Symbols::intern( "symbols-concurrent-" + std::to_string(i) );
+                interned.store( i + 1, std::memory_order_release );
+            }
+        });
+        std::atomic<int> missing{0};
+        std::vector<std::thread> readers;
+        for( int r{0}; r < 3; r++ )
+            readers.emplace_back( [&]{
+                int seen{0};
+                while( seen < count )
+                {
+                    seen = interned.load(std::memory_order_acquire);
+                    for( int i{ seen > 50 ? seen - 50 : 0 }; i < seen; i++ )
+                    {
+                        const auto name{ "symbols-concurrent-" + std::to_string(i) };
+                        const auto symbol{ clp::Symbols::find(name) };
+                        if ( symbol == clp::NoSymbol || clp::Symbols::getName(symbol) != name )
+                            missing++;
+                    }
+                }
+            });
+        writer.join();
+        for( auto& reader : readers )
+            reader.join();
+        BOOST_CHECK_EQUAL( missing.load(), 0 );
+    }
+
+    BOOST_AUTO_TEST_CASE( CommandLineSymbols )
+    {
+        clp::CommandLine cmdline;
+        cmdline.setCommand("symbols-test-command");
+        cmdline.addOption("symbols-test-late");
+        BOOST_CHECK_EQUAL( cmdline.getCommandSymbol(), clp::NoSymbol );
+        BOOST_CHECK_EQUAL( cmdline.getOptionSymbol(0), clp::NoSymbol );
+
+        // Interned after it has been added: still found by its name
+        const auto late{ clp::Symbols::intern("symbols-test-late") };
+        const auto early{ clp::Symbols::intern("symbols-test-early") };
+        cmdline.addOption("symbols-test-early");
+        BOOST_CHECK( cmdline.optionExists("symbols-test-late") );
+        BOOST_CHECK( cmdline.optionExists("symbols-test-early") );
+        BOOST_CHECK_EQUAL( cmdline.getOptionSymbol(1), early );
+        BOOST_CHECK_EQUAL( cmdline.getOptionIndex(early), 1 );
+        BOOST_CHECK_EQUAL( cmdline.getOptionIndex(late), -1 );
+        BOOST_CHECK_THROW( cmdline.getOptionSymbol(2), std::out_of_range );
+
+        // Copies keep the symbols
+        const clp::CommandLineView view( cmdline );
+        BOOST_CHECK_EQUAL( view.getOptionSymbol(1), early );
+        BOOST_CHECK_EQUAL( view.getOptionIndex(early), 1 );
+        BOOST_CHECK( view.optionExists("symbols-test-late") );
+        BOOST_CHECK_EQUAL( clp::CommandLine(view).getOptionSymbol(1), early );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,9 @@
 
 #include "elrat/clp/descriptors.hpp"
 
+#include "common/lexical.hpp"
+#include "common/regex.hpp"
+
 #include "descriptors-unittest/utility.hpp"
 #include "descriptors-unittest/inputdata.hpp"
 
@@ -26,6 +29,143 @@ BOOST_AUTO_TEST_SUITE( UTIL_SELFTEST )
     }
 BOOST_AUTO_TEST_SUITE_END(); // UTIL_SELFTEST
 
+//
+//
+//
+BOOST_AUTO_TEST_SUITE( CONVERT )
+
+    using namespace elrat::clp;
+
+    BOOST_AUTO_TEST_CASE( NUMBERS )
+    {
+        BOOST_CHECK_EQUAL( convert<int>("-39"), -39 );
+        BOOST_CHECK_EQUAL( convert<int>("+39"), 39 );
+        BOOST_CHECK_EQUAL( convert<unsigned>("0xF1"), 0xF1u );
+        BOOST_CHECK_EQUAL( convert<long long>("-9223372036854775808"), INT64_MIN );
+        BOOST_CHECK_EQUAL( convert<float>(".5"), 0.5f );
+        BOOST_CHECK_EQUAL( convert<double>("-1.5e2"), -150.0 );
+    }
+
+    BOOST_AUTO_TEST_CASE( INVALID_NUMBERS )
+    {
+        const std::vector<std::string> invalid {
+            "", " 1", "1 ", "abc", "1abc", "--1", "+-1", "1.5", "0x", "0x-1", "99999999999"
+        };
+        for( auto& arg : invalid )
+        {
+            int x{ 7 };
+            BOOST_CHECK_THROW( convert<int>(arg), InvalidParameterTypeException );
+            BOOST_CHECK_MESSAGE( !convert(arg, x), "[" << arg << "]" );
+        }
+        unsigned u;
+        BOOST_CHECK( !convert("-1", u) );
+        double d;
+        BOOST_CHECK( !convert("inf", d) );
+        BOOST_CHECK( !convert("1.5.", d) );
+    }
+
+    BOOST_AUTO_TEST_CASE( OTHER_TYPES )
+    {
+        BOOST_CHECK_EQUAL( convert<std::string>("abc"), "abc" );
+        BOOST_CHECK_EQUAL( convert<char>("x"), 'x' );
+        bool b;
+        BOOST_CHECK( convert("1", b) && b );
+        BOOST_CHECK( !convert("yes", b) );
+    }
+
+    // A stored value, that T can't represent, is converted like the text
+    BOOST_AUTO_TEST_CASE( VALUES_OUT_OF_RANGE )
+    {
+        BOOST_CHECK_EQUAL( convert<int>("16", Value{ std::int64_t{16} }), 16 );
+        BOOST_CHECK_EQUAL( convert<unsigned>("16", Value{ std::uint64_t{16} }), 16u );
+        BOOST_CHECK_EQUAL( convert<float>("2.5", Value{ 2.5 }), 2.5f );
+        BOOST_CHECK_EQUAL( convert<int>("2", Value{ 2.0 }), 2 );
+        BOOST_CHECK_THROW( convert<int>("4294967296", Value{ std::int64_t{4294967296} }), 
+            InvalidParameterTypeException );
+        BOOST_CHECK_THROW( convert<int>("-4294967295", Value{ std::int64_t{-4294967295} }), 
+            InvalidParameterTypeException );
+        BOOST_CHECK_THROW( convert<std::int64_t>("18446744073709551615", Value{ UINT64_MAX }), 
+            InvalidParameterTypeException );
+        BOOST_CHECK_THROW( convert<unsigned>("-1", Value{ std::int64_t{-1} }), 
+            InvalidParameterTypeException );
+        BOOST_CHECK_THROW( convert<int>("1.5", Value{ 1.5 }), InvalidParameterTypeException );
+        BOOST_CHECK_THROW( convert<int>("1e10", Value{ 1e10 }), InvalidParameterTypeException );
+        BOOST_CHECK_THROW( convert<float>("1e300", Value{ 1e300 }), InvalidParameterTypeException );
+
+        auto cmd{ CommandDescriptor::Create("cmd", "", {
+            TypedParameterDescriptor<std::int64_t>::Create("n") }) };
+        CommandLineView cmdline;
+        cmdline.setCommand("cmd");
+        cmdline.addCommandParameter("4294967296");
+        BOOST_REQUIRE( cmd->validate(cmdline) );
+        BOOST_CHECK_EQUAL( cmdline.getCommandParameterAs<std::int64_t>(0), 4294967296 );
+        BOOST_CHECK_THROW( cmdline.getCommandParameterAs<int>(0), InvalidParameterTypeException );
+    }
+
+    BOOST_AUTO_TEST_CASE( CONSTRAINTS_REJECT_INVALID_NUMBERS )
+    {
+        BOOST_CHECK( !AtLeast(0)->validate("abc") );
+        BOOST_CHECK( !AtMost(0)->validate("abc") );
+        BOOST_CHECK( !InRange(0,10)->validate("") );
+        BOOST_CHECK( !Not(0)->validate("abc") );
+        BOOST_CHECK( !In(0)->validate("abc") );
+        BOOST_CHECK( AtLeast(16)->validate("0x10") );
+    }
+
+    // Values of typed parameters, that the type of the constraint can't
+    // represent, don't pass it
+    BOOST_AUTO_TEST_CASE( CONSTRAINTS_REJECT_VALUES_OUT_OF_RANGE )
+    {
+        const Value negative{ std::int64_t{-4294967295} };
+        const Value maximum{ UINT64_MAX };
+        BOOST_CHECK( !AtLeast(0)->validate("-4294967295", negative) );
+        BOOST_CHECK( !AtMost(10)->validate("18446744073709551615", maximum) );
+        BOOST_CHECK( !InRange(0,10)->validate("18446744073709551615", maximum) );
+        BOOST_CHECK( !In(1)->validate("4294967297", Value{ std::int64_t{4294967297} }) );
+        BOOST_CHECK( !AtLeast(0)->validate("-0.5", Value{ -0.5 }) );
+        BOOST_CHECK( AtMost(10)->validate("10", Value{ std::uint64_t{10} }) );
+        BOOST_CHECK( AtLeast(-1)->validate("-1", Value{ std::int64_t{-1} }) );
+
+        auto parameter{ TypedParameterDescriptor<std::int64_t>::Create( 
+            "n", "", Mandatory, { AtLeast(0) } ) };
+        BOOST_CHECK_THROW( parameter->validate("-4294967295"), InvalidParameterValueException );
+        // Like the text, that isn't an int either
+        BOOST_CHECK_THROW( parameter->validate("4294967295"), InvalidParameterValueException );
+        parameter = TypedParameterDescriptor<std::int64_t>::Create( 
+            "n", "", Mandatory, { AtLeast( std::int64_t{0} ) } );
+        BOOST_CHECK_NO_THROW( parameter->validate("4294967295") );
+        BOOST_CHECK_THROW( parameter->validate("-4294967295"), InvalidParameterValueException );
+    }
+
+    // Checkers and constraints, that are written for std::string
+    class Even : public Constraint
+    {
+    public:
+        bool validate(const std::string& s) const { return convert<int>(s) % 2 == 0; }
+    };
+
+    bool isShort(const std::string& s)
+    {
+        return s.size() < 3;
+    }
+
+    BOOST_AUTO_TEST_CASE( STRING_SIGNATURES )
+    {
+        const std::string arg{ "12" };
+        BOOST_CHECK_EQUAL( convert<int>(arg), 12 );
+        BOOST_CHECK( std::make_shared<Even>()->validate(arg) );
+        TypeChecker checker{ isShort };
+        BOOST_CHECK( checker(arg) && !checker("123") );
+
+        auto parameter{ ParameterDescriptor::Create( "n", "", Mandatory,
+            [](const std::string& s){ return isShort(s); }, { std::make_shared<Even>() } ) };
+        BOOST_CHECK_NO_THROW( parameter->validate("12") );
+        BOOST_CHECK_THROW( parameter->validate("13"), InvalidParameterValueException );
+        BOOST_CHECK_THROW( parameter->validate("124"), InvalidParameterTypeException );
+    }
+
+BOOST_AUTO_TEST_SUITE_END(); // CONVERT
+
 //
 //
 //
@@ -97,6 +237,58 @@ BOOST_AUTO_TEST_SUITE( PARAMETER_VALIDATION )
         }
     
     BOOST_AUTO_TEST_SUITE_END(); // TYPE 
+
+    //
+    // The hand-written type checkers accept the same language as the
+    // regular expressions they replaced.
+    //
+    BOOST_AUTO_TEST_SUITE( TYPE_REFERENCE )
+
+        const auto numbers{ concatenate(
+            permutations("0xX9aF+-.", 4),
+            hexadecimal_zero, hexadecimals, positive_zero, negative_zero, 
+            positive_integers, negative_integers, floating_point_numbers ) };
+
+        const auto names{ concatenate(
+            permutations("aZ_9-.", 4), identifiers, ParameterValidation::names ) };
+
+        const auto paths{ concatenate(
+            permutations("a:\\/ .-(?", 4), win_paths, nix_paths ) };
+
+        const auto email_addresses{ concatenate(
+            permutations("a@.-_", 6), 
+            ParameterValidation::email_addresses, invalid_email_addresses ) };
+
+        BOOST_AUTO_TEST_CASE( DECIMAL )
+        {
+            Compare( lexical::IsDecimal, IsDecimal, numbers );
+            Compare( lexical::IsPositiveDecimal, IsPositiveDecimal, numbers );
+            Compare( lexical::IsHexaDecimal, IsHexaDecimal, numbers );
+        }
+
+        BOOST_AUTO_TEST_CASE( FLOATING_POINT )
+        {
+            Compare( lexical::IsFloatingPoint, IsFloatingPoint, numbers );
+        }
+
+        BOOST_AUTO_TEST_CASE( NAME )
+        {
+            Compare( lexical::IsName, IsName, names );
+            Compare( lexical::IsIdentifier, IsIdentifier, names );
+        }
+
+        BOOST_AUTO_TEST_CASE( PATH )
+        {
+            Compare( lexical::IsWindowsPath, IsWindowsPath, paths );
+            Compare( lexical::IsUnixPath, IsUnixPath, paths );
+        }
+
+        BOOST_AUTO_TEST_CASE( EMAIL_ADDRESS )
+        {
+            Compare( lexical::IsEmailAddress, IsEmailAddress, email_addresses );
+        }
+
+    BOOST_AUTO_TEST_SUITE_END(); // TYPE_REFERENCE
         
     //
     //
@@ -226,6 +418,125 @@ BOOST_AUTO_TEST_SUITE( PARAMETER_VALIDATION )
 
     BOOST_AUTO_TEST_SUITE_END() // CONSTRAINTS_STRING
 
+    //
+    //
+    //
+    BOOST_AUTO_TEST_SUITE( TYPED )
+
+        template <class T>
+        void CheckValue( 
+            ParameterDescriptorPtr descriptor, 
+            const std::string& arg, 
+            value_type_t<T> expected )
+        {
+            Value value{ descriptor->validate(arg) };
+            BOOST_REQUIRE_MESSAGE( std::holds_alternative<value_type_t<T>>(value), arg );
+            BOOST_CHECK_EQUAL( std::get<value_type_t<T>>(value), expected );
+        }
+
+        void CheckInvalidType(
+            ParameterDescriptorPtr descriptor,
+            const std::vector<std::string>& args )
+        {
+            for( auto& arg : args )
+                BOOST_CHECK_THROW( descriptor->validate(arg), InvalidParameterTypeException );
+        }
+
+        BOOST_AUTO_TEST_CASE( NATURAL_NUMBER )
+        {
+            auto descriptor{ TypedParameterDescriptor<unsigned>::Create("n") };
+            for( auto& args : { positive_zero, positive_integers, hexadecimal_zero, hexadecimals } )
+                for( auto& arg : args )
+                    BOOST_CHECK_NO_THROW( descriptor->validate(arg) );
+            CheckValue<unsigned>( descriptor, "+1337", 1337 );
+            CheckValue<unsigned>( descriptor, "0xF1", 0xF1 );
+            CheckInvalidType( descriptor, negative_integers );
+            CheckInvalidType( descriptor, floating_point_numbers );
+            CheckInvalidType( descriptor, { "", "+", "0x", "-0x1", "+0x1", "1 ", "x1" } );
+        }
+
+        BOOST_AUTO_TEST_CASE( WHOLE_NUMBER )
+        {
+            auto descriptor{ TypedParameterDescriptor<int>::Create("n") };
+            for( auto& args : { negative_zero, negative_integers, hexadecimals } )
+                for( auto& arg : args )
+                    BOOST_CHECK_NO_THROW( descriptor->validate(arg) );
+            CheckValue<int>( descriptor, "-39", -39 );
+            CheckValue<int>( descriptor, "0x0A", 10 );
+            CheckInvalidType( descriptor, floating_point_numbers );
+            CheckInvalidType( descriptor, { "--1", "+-1", "1-", "0xG" } );
+        }
+
+        BOOST_AUTO_TEST_CASE( REAL_NUMBER )
+        {
+            auto descriptor{ TypedParameterDescriptor<double>::Create("x") };
+            for( auto& arg : floating_point_numbers )
+                BOOST_CHECK_NO_THROW( descriptor->validate(arg) );
+            CheckValue<double>( descriptor, "+1.5", 1.5 );
+            CheckValue<double>( descriptor, "-.25", -0.25 );
+            CheckValue<double>( descriptor, "1e3", 1000.0 );
+            CheckInvalidType( descriptor, { ".", "inf", "nan", "1.2.3", "0x1" } );
+        }
+
+        BOOST_AUTO_TEST_CASE( SAME_LANGUAGE_AS_TYPE_CHECKERS )
+        {
+            auto whole{ TypedParameterDescriptor<long long>::Create("n")->getTypeChecker() };
+            auto natural{ TypedParameterDescriptor<unsigned long long>::Create("n")->getTypeChecker() };
+            const auto numbers{ permutations("0xX9aF+-.", 4) };
+            Compare( whole, ParameterType::WholeNumber, numbers );
+            Compare( natural, ParameterType::NaturalNumber, numbers );
+        }
+
+        BOOST_AUTO_TEST_CASE( OUT_OF_RANGE )
+        {
+            auto descriptor{ TypedParameterDescriptor<short>::Create("n") };
+            CheckValue<short>( descriptor, "-32768", -32768 );
+            CheckInvalidType( descriptor, { "32768", "0x10000" } );
+        }
+
+        BOOST_AUTO_TEST_CASE( CONSTRAINTS )
+        {
+            auto descriptor{ TypedParameterDescriptor<int>::Create(
+                "n", "", Mandatory, { InRange(10,19) }) };
+            BOOST_CHECK_NO_THROW( descriptor->validate("0x10") );
+            BOOST_CHECK_THROW( descriptor->validate("0x14"), InvalidParameterValueException );
+            BOOST_CHECK_THROW( descriptor->validate("9"), InvalidParameterValueException );
+        }
+
+        BOOST_AUTO_TEST_CASE( COMMAND_LINE_VIEW )
+        {
+            auto cmd{ CommandDescriptor::Create("cmd", "", {
+                TypedParameterDescriptor<int>::Create("n"),
+                ParameterDescriptor::Create("text") }, {
+                OptionDescriptor::Create("x", "", {
+                    TypedParameterDescriptor<double>::Create("x") }) }) };
+            CommandLineView cmdline;
+            cmdline.setCommand("cmd");
+            cmdline.addCommandParameter("0x1F");
+            cmdline.addCommandParameter("0x1F");
+            cmdline.addOption("x");
+            cmdline.addOptionParameter("2.5");
+
+            // A read-only view can't keep the values
+            BOOST_CHECK( cmd->validate( static_cast<const CommandLineView&>(cmdline) ) );
+            BOOST_CHECK( std::holds_alternative<std::monostate>(cmdline.getCommandParameterValue(0)) );
+
+            BOOST_CHECK( cmd->validate(cmdline) );
+            BOOST_CHECK( std::get<std::int64_t>(cmdline.getCommandParameterValue(0)) == 31 );
+            BOOST_CHECK( std::holds_alternative<std::monostate>(cmdline.getCommandParameterValue(1)) );
+            BOOST_CHECK_EQUAL( std::get<double>(cmdline.getOptionParameterValue(0,0)), 2.5 );
+            BOOST_CHECK_EQUAL( cmdline.getCommandParameterAs<int>(0), 31 );
+            BOOST_CHECK_EQUAL( cmdline.getCommandParameterAs<std::string>(1), "0x1F" );
+            BOOST_CHECK_EQUAL( cmdline.getOptionParameterAs<float>("x",0), 2.5f );
+
+            cmdline.clear();
+            cmdline.setCommand("cmd");
+            cmdline.addCommandParameter("1");
+            BOOST_CHECK( std::holds_alternative<std::monostate>(cmdline.getCommandParameterValue(0)) );
+        }
+
+    BOOST_AUTO_TEST_SUITE_END() // TYPED
+
 BOOST_AUTO_TEST_SUITE_END(); // PARAMETER_VALIDATION
 
 //
@@ -324,5 +635,79 @@ BOOST_AUTO_TEST_SUITE( COMMAND_VALIDATION )
         for( auto& c : cls )
             CheckThrow<TooManyParametersException>(cmd, c);
     }
+
+    BOOST_AUTO_TEST_CASE( MATCHED_OPTION_DESCRIPTORS )
+    {
+        BOOST_REQUIRE( cmd->findOption("color") );
+        BOOST_CHECK_EQUAL( cmd->findOption("color")->getName(), "color" );
+        BOOST_CHECK( !cmd->findOption("colour") );
+
+        CommandLineView cmdline;
+        cmdline.setCommand("cube");
+        cmdline.addCommandParameter("1.5");
+        cmdline.addOption("ice");
+        cmdline.addOption("color");
+        cmdline.addOptionParameter("red");
+        BOOST_CHECK( !cmdline.getOptionDescriptor(0) );
+        BOOST_CHECK( cmd->validate(cmdline) );
+        BOOST_CHECK_EQUAL( cmdline.getOptionDescriptor(0), cmd->findOption("ice") );
+        BOOST_CHECK_EQUAL( cmdline.getOptionDescriptor(1), cmd->findOption("color") );
+
+        cmdline.addOption("colour");
+        BOOST_CHECK_THROW( cmd->validate(cmdline), InvalidOptionException );
+    }
 BOOST_AUTO_TEST_SUITE_END(); // COMMAND_VALIDATION 
 
+
+//
+//
+//
+BOOST_AUTO_TEST_SUITE( DESCRIPTOR_MAP )
+    using namespace elrat::clp;
+
+    CommandDescriptors createDescriptors(std::initializer_list<std::string> names)
+    {
+        CommandDescriptors descriptors;
+        for( auto& name : names )
+            descriptors.push_back( CommandDescriptor::Create(name) );
+        return descriptors;
+    }
+
+    BOOST_AUTO_TEST_CASE( ATTACH )
+    {
+        DescriptorMap map;
+        auto a{ CommandDescriptor::Create("a") };
+        map.attach( a );
+        BOOST_CHECK_EQUAL( map.find("a"), a.get() );
+        BOOST_CHECK( map.find("b") == nullptr );
+        BOOST_CHECK_THROW( map.attach(a), AlreadyInUseException );
+        BOOST_CHECK_THROW( map.attach( CommandDescriptor::Create("a") ), AlreadyInUseException );
+        BOOST_CHECK_EQUAL( map.getCommandDescriptors().size(), 1 );
+    }
+
+    BOOST_AUTO_TEST_CASE( ATTACH_RANGE )
+    {
+        DescriptorMap map;
+        map.attach( createDescriptors({ "a", "b" }) );
+        map.attach( createDescriptors({ "c" }) );
+        auto& descriptors{ map.getCommandDescriptors() };
+        BOOST_REQUIRE_EQUAL( descriptors.size(), 3 );
+        BOOST_CHECK_EQUAL( descriptors[0]->getName(), "a" );
+        BOOST_CHECK_EQUAL( descriptors[2]->getName(), "c" );
+        BOOST_CHECK( map.find("b") );
+    }
+
+    BOOST_AUTO_TEST_CASE( ATTACH_RANGE_ALL_OR_NOTHING )
+    {
+        DescriptorMap map;
+        map.attach( createDescriptors({ "a" }) );
+        BOOST_CHECK_THROW( map.attach( createDescriptors({ "b", "a", "c" }) ), AlreadyInUseException );
+        BOOST_CHECK_THROW( map.attach( createDescriptors({ "b", "c", "b" }) ), AlreadyInUseException );
+        BOOST_CHECK_EQUAL( map.getCommandDescriptors().size(), 1 );
+        BOOST_CHECK( !map.find("b") );
+        BOOST_CHECK( !map.find("c") );
+        BOOST_CHECK_NO_THROW( map.attach( createDescriptors({ "b", "c" }) ) );
+        BOOST_CHECK_EQUAL( map.getCommandDescriptors().size(), 3 );
+    }
+
+BOOST_AUTO_TEST_SUITE_END(); // DESCRIPTOR_MAP
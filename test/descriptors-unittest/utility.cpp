@@ -12,6 +12,22 @@ std::string toString(const std::vector<std::string>& strings)
     return result;
 }
 
+std::vector<std::string> permutations(const std::string& alphabet, int length)
+{
+    std::vector<std::string> result{ "" };
+    std::vector<std::string> previous{ "" };
+    for( int i{0}; i < length; i++ )
+    {
+        std::vector<std::string> longer;
+        for( auto& s : previous )
+            for( char c : alphabet )
+                longer.push_back( s + c );
+        result.insert( result.end(), longer.begin(), longer.end() );
+        previous = std::move(longer);
+    }
+    return result;
+}
+
 namespace ParameterValidation 
 {
     
@@ -64,6 +80,15 @@ namespace ParameterValidation
         intern::check(false,constraint,candidates);
 	}
 
+    void Compare(
+        TypeChecker typechecker,
+        TypeChecker reference,
+	    const std::vector<std::string>& candidates )
+    {
+        for( auto& c : candidates )
+            BOOST_CHECK_MESSAGE( typechecker(c) == reference(c), "[" << c << "]" );
+    }
+
 
 }
 
@@ -14,6 +14,12 @@ std::vector<std::string> convertRangeToStrings(T from, T to, T incr = 1 );
 
 std::string toString(const std::vector<std::string>&); 
 
+// All strings over 'alphabet' up to the given length
+std::vector<std::string> permutations(const std::string& alphabet, int length);
+
+template <class...VECTORS>
+std::vector<std::string> concatenate(const VECTORS&...);
+
 namespace ParameterValidation
 {
 	void Check(
@@ -31,6 +37,12 @@ namespace ParameterValidation
 	void FailCheck(
 	    elrat::clp::ConstraintPtr, 
 	    const std::vector<std::string>&);
+
+    // Checks that both type checkers agree on each candidate
+    void Compare(
+        elrat::clp::TypeChecker,
+        elrat::clp::TypeChecker reference,
+	    const std::vector<std::string>&);
 }    
 
 namespace OptionValidation
@@ -98,13 +110,24 @@ std::vector<std::string> convertRangeToStrings(
     return result;
 }
 
+template <class...VECTORS>
+std::vector<std::string> concatenate(const VECTORS&...vectors)
+{
+    std::vector<std::string> result;
+    ( result.insert( result.end(), vectors.begin(), vectors.end() ), ... );
+    return result;
+}
+
 template <class EXCEPTION>
 void OptionValidation::CheckThrow(
 	elrat::clp::OptionDescriptorPtr option, 
     const std::string& opt_name,
 	const std::vector<std::string>& opt_parameters)
 {   
-    intern::CheckThrow<EXCEPTION>(
+    using Validate = bool (elrat::clp::OptionDescriptor::*)(
+        const elrat::clp::Argument&, 
+        const elrat::clp::Arguments&) const;
+    intern::CheckThrow<EXCEPTION, Validate>(
         &elrat::clp::OptionDescriptor::validate,
         *option,
         opt_name,
@@ -116,7 +139,9 @@ void CommandValidation::CheckThrow(
     elrat::clp::CommandDescriptorPtr cmd_desc, 
     const elrat::clp::CommandLine& input )
 {
-    intern::CheckThrow<EXCEPTION>(
+    using Validate = bool (elrat::clp::CommandDescriptor::*)(
+        const elrat::clp::CommandLine&) const;
+    intern::CheckThrow<EXCEPTION, Validate>(
         &elrat::clp::CommandDescriptor::validate,
         *cmd_desc,
         input );
@@ -2,6 +2,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -43,6 +44,14 @@ namespace valid
         ,"x a --option b"
         ,"x a --option = z b"
     };
+
+    // Input and the expected command parameters and parameter of 'option'
+    const std::vector<std::vector<std::string>> tokens {
+         {"x a --option=z b", "a", "b", "z"}
+        ,{"x\ta\n--option =\rz   b", "a", "b", "z"}
+        ,{"x \"a b\" --option=\"=\" \"c\"", "\"a b\"", "\"c\"", "\"=\""}
+        ,{"x \"\"a --option=\"b c", "\"\"a", "c", "\"b"}
+    };
 }
 
 namespace invalid
@@ -66,6 +75,23 @@ namespace invalid
         ,"x -abc --b"
         ,"x --b -abc"
     };
+
+    // Input, rejected token and its offset
+    struct Diagnostic
+    {
+        std::string input;
+        clp::ErrorCode code;
+        std::string token;
+        std::size_t offset;
+    };
+    const std::vector<Diagnostic> diagnostics {
+         {"  ", clp::ErrorCode::EmptyInput, "", std::string::npos}
+        ,{" 1-command a", clp::ErrorCode::InvalidCommandName, "1-command", 1}
+        ,{"x a = b", clp::ErrorCode::UnexpectedToken, "=", 4}
+        ,{"x --a = = b", clp::ErrorCode::None, "", std::string::npos}
+        ,{"x -abc -cba", clp::ErrorCode::RedundantOptionInPack, "-cba", 7}
+        ,{"x -a  --a", clp::ErrorCode::RedundantOption, "--a", 6}
+    };
 }
 
 void TryParsingCatchInputException(clp::Parser*, const std::string&);
@@ -126,6 +152,126 @@ BOOST_AUTO_TEST_SUITE( ParserTestSuite )
         }
     }
 
+    BOOST_AUTO_TEST_CASE( TokenContents )
+    {
+        for( auto& expected : valid::tokens )
+        {
+            auto cl{ t.parse(expected[0]) };
+            BOOST_REQUIRE_MESSAGE( cl.getCommandParameters().size() == 2, expected[0] );
+            BOOST_CHECK_EQUAL( cl.getCommandParameter(0), expected[1] );
+            BOOST_CHECK_EQUAL( cl.getCommandParameter(1), expected[2] );
+            BOOST_REQUIRE_MESSAGE( cl.optionExists("option"), expected[0] );
+            BOOST_REQUIRE_EQUAL( cl.getOptionParameters("option").size(), 1 );
+            BOOST_CHECK_EQUAL( cl.getOptionParameters("option")[0], expected[3] );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE( TokenViews )
+    {
+        BOOST_REQUIRE( t.providesViews() );
+        clp::CommandLineView view;
+        for( auto& expected : valid::tokens )
+        {
+            const std::string& input{ expected[0] };
+            t.parse( input, view );
+            BOOST_REQUIRE_EQUAL( view.getCommandParameters().size(), 2 );
+            BOOST_CHECK_EQUAL( view.getCommandParameter(0), expected[1] );
+            BOOST_CHECK_EQUAL( view.getCommandParameter(1), expected[2] );
+            BOOST_REQUIRE_EQUAL( view.getOptionParameters("option").size(), 1 );
+            BOOST_CHECK_EQUAL( view.getOptionParameters("option")[0], expected[3] );
+            // The tokens refer to the input
+            auto parameter{ view.getOptionParameters("option")[0] };
+            BOOST_CHECK( parameter.data() >= input.data() );
+            BOOST_CHECK( parameter.data() + parameter.size() <= input.data() + input.size() );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE( Diagnostics )
+    {
+        clp::CommandLineView view;
+        for( auto& expected : invalid::diagnostics )
+        {
+            auto diagnostic{ t.tryParse( expected.input, view ) };
+            diagnostic.locate( expected.input );
+            BOOST_CHECK_MESSAGE( diagnostic.getCode() == expected.code, expected.input );
+            BOOST_CHECK_EQUAL( diagnostic.getToken(), expected.token );
+            BOOST_CHECK_EQUAL( diagnostic.getOffset(), expected.offset );
+            if ( diagnostic.ok() )
+                continue;
+            // The message is the one of the exception thrown by parse()
+            try
+            {
+                t.parse( expected.input, view );
+                BOOST_ERROR( "No exception: " + expected.input );
+            }
+            catch( const clp::InputException& e )
+            {
+                BOOST_CHECK_EQUAL( diagnostic.getMessage(), e.what() );
+            }
+            BOOST_CHECK_THROW( diagnostic.raise(), clp::InputException );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE( DiagnosticMessages )
+    {
+        clp::CommandLineView view;
+        BOOST_CHECK_EQUAL( 
+            t.tryParse( "x --a --a", view ).getMessage(), 
+            "InputException: --a [Already exists]" );
+        BOOST_CHECK_EQUAL( 
+            t.tryParse( "", view ).getMessage(), 
+            "InputException: NativeParser::parse() [Received empty string]" );
+    }
+
+    // Arguments are tokens as they are, without quotes and with whitespace;
+    // only "--option=parameter" is split.
+    BOOST_AUTO_TEST_CASE( ArgumentVector )
+    {
+        const char* const argv[]{ 
+            "copy", "my file", "-ab", "--count=3", "--name", "=", "x=y", "--to", "a b" };
+        clp::CommandLineView view;
+        auto diagnostic{ t.tryParse( 9, argv, view ) };
+        BOOST_REQUIRE( diagnostic.ok() );
+        BOOST_CHECK_EQUAL( view.getCommand(), "copy" );
+        BOOST_REQUIRE_EQUAL( view.getCommandParameters().size(), 2 );
+        BOOST_CHECK_EQUAL( view.getCommandParameter(0), "my file" );
+        BOOST_CHECK_EQUAL( view.getCommandParameter(1), "a b" );
+        BOOST_CHECK( view.optionExists("a") && view.optionExists("b") );
+        BOOST_REQUIRE_EQUAL( view.getOptionParameters("count").size(), 1 );
+        BOOST_CHECK_EQUAL( view.getOptionParameters("count")[0], "3" );
+        BOOST_REQUIRE_EQUAL( view.getOptionParameters("name").size(), 1 );
+        BOOST_CHECK_EQUAL( view.getOptionParameters("name")[0], "x=y" );
+        BOOST_CHECK( view.optionExists("to") );
+        // The tokens refer to the arguments
+        BOOST_CHECK_EQUAL( view.getCommandParameter(0).data(), argv[1] );
+        BOOST_CHECK_EQUAL( view.getOptionParameters("count")[0].data(), argv[3] + 8 );
+
+        // Same as the joined line, where it needs no quotes
+        const char* const simple[]{ "copy", "-ab", "file", "--count", "=", "3" };
+        auto cmdline{ t.parse( 6, simple ) };
+        auto joined{ t.parse( std::string("copy -ab file --count = 3") ) };
+        BOOST_CHECK_EQUAL( cmdline.getCommand(), joined.getCommand() );
+        BOOST_CHECK( std::ranges::equal( 
+            cmdline.getCommandParameters(), joined.getCommandParameters() ) );
+        BOOST_CHECK_EQUAL( cmdline.getOptionCount(), joined.getOptionCount() );
+        BOOST_CHECK( std::ranges::equal( 
+            cmdline.getOptionParameters("count"), joined.getOptionParameters("count") ) );
+    }
+
+    BOOST_AUTO_TEST_CASE( ArgumentVectorDiagnostics )
+    {
+        clp::CommandLineView view;
+        BOOST_CHECK( t.tryParse( 0, nullptr, view ).getCode() == clp::ErrorCode::EmptyInput );
+        const char* const command[]{ "--copy" };
+        BOOST_CHECK( t.tryParse( 1, command, view ).getCode() == clp::ErrorCode::InvalidCommandName );
+        const char* const equal_sign[]{ "copy", "=" };
+        auto diagnostic{ t.tryParse( 2, equal_sign, view ) };
+        BOOST_CHECK( diagnostic.getCode() == clp::ErrorCode::UnexpectedToken );
+        BOOST_CHECK_EQUAL( diagnostic.getToken().data(), equal_sign[1] );
+        const char* const redundant[]{ "copy", "--x=1", "--x" };
+        BOOST_CHECK( t.tryParse( 3, redundant, view ).getCode() == clp::ErrorCode::RedundantOption );
+        BOOST_CHECK_THROW( t.parse( 3, redundant ), clp::InputException );
+    }
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,90 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "parser/nativeparser/tokenclassification.hpp"
+
+// The predicates are usable at compile time
+static_assert( token::IsIdentifierPlus("_cmd-name") );
+static_assert( token::IsIdentifierPlus("x") );
+static_assert( !token::IsIdentifierPlus("1-command") );
+static_assert( !token::IsIdentifierPlus("") );
+static_assert( token::IsOption("--o") );
+static_assert( token::IsOption("--_option-name2") );
+static_assert( !token::IsOption("--") );
+static_assert( !token::IsOption("---a") );
+static_assert( !token::IsOption("-a") );
+static_assert( token::IsOptionPack("-abc") );
+static_assert( !token::IsOptionPack("-") );
+static_assert( !token::IsOptionPack("-a1") );
+static_assert( !token::IsOptionPack("--a") );
+static_assert( token::IsEqualSign("=") );
+static_assert( !token::IsEqualSign("==") );
+
+namespace
+{
+    const std::vector<std::string> tokens {
+         "", "=", "==", "x", "_", "-", "--", "---", "-a", "-abc", "-a-b", "-a1"
+        ,"--a", "--_", "--1", "--a-b", "--a_b1", "---a", "--a=", "cmd", "_cmd-name"
+        ,"cmd123", "1-command", "a b", "\"a\"", "a.b", "-.01f", "+1.5", "\xe4", "-\xe4"
+    };
+
+    std::vector<std::string> permutations(const std::string& alphabet, int length)
+    {
+        std::vector<std::string> result{ "" };
+        for( int i{0}; i < length; i++ )
+        {
+            std::vector<std::string> longer;
+            for( auto& s : result )
+                for( char c : alphabet )
+                    longer.push_back( s + c );
+            result.insert( result.end(), longer.begin(), longer.end() );
+        }
+        return result;
+    }
+
+    template <class CONSTEXPR_PREDICATE>
+    void compare(
+        CONSTEXPR_PREDICATE predicate,
+        const RegEx& reference,
+        const std::vector<std::string>& candidates )
+    {
+        for( auto& candidate : candidates )
+            BOOST_CHECK_MESSAGE(
+                predicate(candidate) == reference(candidate),
+                "[" << candidate << "]" );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( TokenClassificationTestSuite )
+
+    const auto candidates{ [] {
+        auto result{ permutations("-_=aZ1.", 4) };
+        result.insert( result.end(), tokens.begin(), tokens.end() );
+        return result;
+    }() };
+
+    BOOST_AUTO_TEST_CASE( IdentifierPlus )
+    {
+        compare( token::IsIdentifierPlus, token::regex::IsIdentifierPlus, candidates );
+    }
+
+    BOOST_AUTO_TEST_CASE( Option )
+    {
+        compare( token::IsOption, token::regex::IsOption, candidates );
+    }
+
+    BOOST_AUTO_TEST_CASE( OptionPack )
+    {
+        compare( token::IsOptionPack, token::regex::IsOptionPack, candidates );
+    }
+
+    BOOST_AUTO_TEST_CASE( EqualSign )
+    {
+        compare( token::IsEqualSign, token::regex::IsEqualSign, candidates );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,187 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+#include "elrat/clp/processor.hpp"
+
+// Counts the allocations of the calling thread
+namespace
+{
+    thread_local std::size_t allocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    if ( void* p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Used by std::pmr::new_delete_resource()
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations++;
+    const auto align{ static_cast<std::size_t>( alignment ) };
+    if ( void* p = std::aligned_alloc( align, ( ( size ? size : 1 ) + align - 1 ) / align * align ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+BOOST_AUTO_TEST_SUITE( ALLOCATIONS )
+
+    using namespace elrat::clp;
+
+    const int Iterations{ 100 };
+
+    // Allocations of the function, called repeatedly after a warm-up
+    template <class FUNCTION>
+    std::size_t countAllocations(FUNCTION function)
+    {
+        for( int i{0}; i < 3; i++ )
+            function();
+        const auto before{ allocations };
+        for( int i{0}; i < Iterations; i++ )
+            function();
+        return allocations - before;
+    }
+
+    void keep(const CommandLine& cmdline)
+    {
+        BOOST_REQUIRE( cmdline );
+    }
+
+    // Hands out CommandLines only
+    class CopyingParser : public Parser
+    {
+    public:
+        CommandLine parse(const std::string& input) const override { return native.parse(input); }
+        void parse(const std::string& input, CommandLine& result) const override { native.parse(input, result); }
+        const std::string& getSyntaxDescription() const override { return native.getSyntaxDescription(); }
+    private:
+        NativeParser native;
+    };
+
+    CommandDescriptorPtr createDescriptor()
+    {
+        return CommandDescriptor::Create("copy", "", {
+                ParameterDescriptor::Create("from"),
+                ParameterDescriptor::Create("to") }, {
+                OptionDescriptor::Create("force"),
+                OptionDescriptor::Create("level", "", {
+                    TypedParameterDescriptor<int>::Create("level") }) });
+    }
+
+    // Longer than the inline capacity of a CommandLine
+    const std::string Line{
+        "copy --force --level = 3 /a/rather/long/source/path /and/a/rather/long/target/path" };
+
+    BOOST_AUTO_TEST_CASE( REUSED_COMMANDLINE )
+    {
+        NativeParser parser;
+        CommandLine cmdline;
+        BOOST_CHECK_EQUAL( countAllocations( [&]{ parser.parse( Line, cmdline ); } ), 0 );
+        BOOST_CHECK_EQUAL( cmdline.getCommandParameter(1), "/and/a/rather/long/target/path" );
+        // A new one allocates for the text, that doesn't fit inline
+        BOOST_CHECK_GT( countAllocations( [&]{ keep( parser.parse( Line ) ); } ), 0 );
+    }
+
+    BOOST_AUTO_TEST_CASE( PROCESS_VIEWS )
+    {
+        Processor processor;
+        int received{0};
+        processor.attach( createDescriptor(), [&](const CommandLineView& cmdline) {
+            received += cmdline.getOptionParameterAs<int>("level", 0);
+        });
+        BOOST_CHECK_EQUAL( countAllocations( [&]{ processor.process( Line ); } ), 0 );
+        BOOST_CHECK_EQUAL( countAllocations( [&]{ processor.tryProcess( Line ); } ), 0 );
+        BOOST_CHECK_EQUAL( received, 3 * 2 * ( 3 + Iterations ) );
+    }
+
+    BOOST_AUTO_TEST_CASE( PROCESS_COMMANDLINES )
+    {
+        Processor processor( std::make_shared<CopyingParser>() );
+        int received{0};
+        processor.attach( createDescriptor(), [&](const CommandLine& cmdline) {
+            received += cmdline.getOptionParameterAs<int>("level", 0);
+        });
+        BOOST_CHECK_EQUAL( countAllocations( [&]{ processor.process( Line ); } ), 0 );
+        BOOST_CHECK_EQUAL( received, 3 * ( 3 + Iterations ) );
+    }
+
+    // Everything comes from the arena, even on the first call
+    BOOST_AUTO_TEST_CASE( MEMORY_RESOURCE )
+    {
+        Processor processor;
+        int received{0};
+        processor.attach( createDescriptor(), [&](const CommandLineView& cmdline) {
+            received += cmdline.getOptionParameterAs<int>("level", 0);
+        });
+        processor.process( Line );
+
+        char buffer[4096];
+        std::pmr::monotonic_buffer_resource arena( 
+            buffer, sizeof(buffer), std::pmr::null_memory_resource() );
+        const auto before{ allocations };
+        BOOST_CHECK( processor.tryProcess( Line, &arena ).ok() );
+        BOOST_CHECK_EQUAL( allocations - before, 0 );
+        BOOST_CHECK_EQUAL( received, 6 );
+        BOOST_CHECK_THROW( processor.tryProcess( Line, nullptr ), NullptrAssignmentException );
+
+        Processor copying( std::make_shared<CopyingParser>() );
+        copying.attach( createDescriptor(), [&](const CommandLine& cmdline) {
+            BOOST_CHECK_EQUAL( cmdline.getMemoryResource(), &arena );
+        });
+        copying.process( Line, &arena );
+
+        // Exhausted
+        std::pmr::monotonic_buffer_resource tiny( 
+            buffer, 16, std::pmr::null_memory_resource() );
+        BOOST_CHECK_THROW( processor.process( Line, &tiny ), std::bad_alloc );
+    }
+
+    // A command, that processes another line, uses buffers of its own
+    BOOST_AUTO_TEST_CASE( NESTED_PROCESSING )
+    {
+        Processor processor;
+        std::string received;
+        processor.attach( createDescriptor(), [&](const CommandLineView& cmdline) {
+            received = cmdline.getCommandParameter(0);
+        });
+        processor.attach( CommandDescriptor::Create("twice", "", {
+                ParameterDescriptor::Create("line") }),
+            [&](const CommandLineView& cmdline) {
+                processor.process( Line );
+                BOOST_CHECK_EQUAL( cmdline.getCommandParameter(0), "copy" );
+            });
+        processor.process( "twice copy" );
+        BOOST_CHECK_EQUAL( received, "/a/rather/long/source/path" );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
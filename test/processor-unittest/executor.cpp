@@ -0,0 +1,114 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <elrat/clp/executor.hpp>
+
+using namespace elrat::clp;
+
+BOOST_AUTO_TEST_SUITE( ExecutorTestSuite )
+
+    BOOST_AUTO_TEST_CASE( RunsAllTasks )
+    {
+        std::atomic<int> count{0};
+        {
+            Executor executor(4);
+            BOOST_CHECK_EQUAL( executor.getThreadCount(), 4 );
+            for( int i{0}; i < 10000; i++ )
+                executor.post( [&count]{ count++; } );
+        }
+        BOOST_CHECK_EQUAL( count.load(), 10000 );
+    }
+
+    BOOST_AUTO_TEST_CASE( DefaultThreadCount )
+    {
+        auto executor{ Executor::Create() };
+        BOOST_CHECK_GE( executor->getThreadCount(), 1 );
+    }
+
+    BOOST_AUTO_TEST_CASE( KeepsOrderPerKey )
+    {
+        const std::vector<std::string> keys{ "a", "b", "c" };
+        std::mutex mutex;
+        std::vector<std::vector<int>> seen( keys.size() );
+        {
+            Executor executor(4);
+            for( int i{0}; i < 3000; i++ )
+            {
+                const auto k{ i % keys.size() };
+                executor.post( keys[k], [&mutex, &seen, k, i]{
+                    std::lock_guard<std::mutex> lock( mutex );
+                    seen[k].push_back( i );
+                });
+            }
+        }
+        for( std::size_t k{0}; k < keys.size(); k++ )
+        {
+            BOOST_REQUIRE_EQUAL( seen[k].size(), 1000 );
+            for( std::size_t i{1}; i < seen[k].size(); i++ )
+                BOOST_CHECK_LT( seen[k][i-1], seen[k][i] );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE( ShutdownRunsTasksPostedByTasks )
+    {
+        std::atomic<int> count{0};
+        Executor executor(2);
+        for( int i{0}; i < 100; i++ )
+            executor.post( [&executor, &count]{
+                executor.post( [&executor, &count]{
+                    executor.post( "key", [&count]{ count++; } );
+                    count++;
+                });
+                count++;
+            });
+        executor.shutdown();
+        BOOST_CHECK_EQUAL( count.load(), 300 );
+    }
+
+    // Tasks, that another thread posts while shutting down, either run or
+    // are refused, but never lost
+    BOOST_AUTO_TEST_CASE( ShutdownRunsTasksPostedByOtherThreads )
+    {
+        std::atomic<int> ran{0};
+        std::atomic<int> posted{0};
+        Executor executor(2);
+        std::thread poster( [&]{
+            try
+            {
+                for( int i{0}; i < 200000; i++ )
+                {
+                    executor.post( [&ran]{ ran++; } );
+                    posted++;
+                    std::this_thread::sleep_for( std::chrono::microseconds(10) );
+                }
+            }
+            catch( const std::logic_error& )
+            {
+            }
+        });
+        while( posted < 100 )
+            std::this_thread::yield();
+        executor.shutdown();
+        poster.join();
+        BOOST_CHECK_EQUAL( ran.load(), posted.load() );
+    }
+
+    BOOST_AUTO_TEST_CASE( PostAfterShutdown )
+    {
+        Executor executor(1);
+        executor.shutdown();
+        executor.shutdown();
+        BOOST_CHECK_THROW( executor.post( []{} ), std::logic_error );
+        BOOST_CHECK_THROW( executor.post( "key", []{} ), std::logic_error );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,8 +2,26 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "elrat/clp/parserwrapper.hpp"
 #include "elrat/clp/processor.hpp"
 
+#include "processor/builtin.hpp"
+#include "processor/commandwrapper.hpp"
 #include "processor-unittest/utility.hpp"
 #include "processor-unittest/inputdata.hpp"
 
@@ -56,6 +74,92 @@ BOOST_AUTO_TEST_SUITE( PROCESSOR )
 
     }
 
+    BOOST_AUTO_TEST_CASE( COMMAND_LINE_VIEW )
+    {
+        std::string received;
+        auto descriptor{ CommandDescriptor::Create("echo", "", {
+            ParameterDescriptor::Create("text") }) };
+        processor.attach( descriptor, [&](const CommandLineView& cmdline) {
+            received = std::string( cmdline.getCommandParameter(0) );
+        });
+        BOOST_CHECK_NO_THROW( processor.process("echo \"a b\"") );
+        BOOST_CHECK_EQUAL( received, "\"a b\"" );
+    }
+
+    // Callables, that accept both kinds of command lines, get the 
+    // CommandLine; the others get what they accept
+    BOOST_AUTO_TEST_CASE( GENERIC_FUNCTIONS )
+    {
+        Processor processor;
+        std::vector<std::string> received;
+        processor.attach( CommandDescriptor::Create("a"), [&](auto& cmdline) {
+            static_assert( std::is_same_v<decltype(cmdline), const CommandLine&> );
+            received.push_back( std::string( cmdline.getCommand() ) );
+        });
+        processor.attach( CommandDescriptor::Create("b"), [&](const auto& cmdline) {
+            static_assert( std::is_same_v<decltype(cmdline), const CommandLine&> );
+            received.push_back( std::string( cmdline.getCommand() ) );
+        });
+        processor.attach( CommandDescriptor::Create("c") );
+        processor.attach( "c", [&](const CommandLineView& cmdline) {
+            received.push_back( std::string( cmdline.getCommand() ) );
+        });
+        processor.attach( CommandDescriptor::Create("d") );
+        processor.attach( "d", [&](const CommandLine& cmdline) {
+            received.push_back( cmdline.getCommand() );
+        });
+        processor.process("a");
+        processor.process("b");
+        processor.process("c");
+        processor.process("d");
+        BOOST_CHECK( received == std::vector<std::string>({ "a", "b", "c", "d" }) );
+    }
+
+    BOOST_AUTO_TEST_CASE( TYPED_PARAMETERS )
+    {
+        int received{0};
+        auto descriptor{ CommandDescriptor::Create("sum", "", {
+            TypedParameterDescriptor<int>::Create("a"),
+            TypedParameterDescriptor<int>::Create("b", "", Mandatory, { AtMost(100) }) }) };
+        processor.attach( descriptor, [&](const CommandLineView& cmdline) {
+            received = cmdline.getCommandParameterAs<int>(0) 
+                     + cmdline.getCommandParameterAs<int>(1);
+        });
+        BOOST_CHECK_NO_THROW( processor.process("sum 0x10 -1") );
+        BOOST_CHECK_EQUAL( received, 15 );
+        BOOST_CHECK_THROW( processor.process("sum 1 0x65"), InvalidParameterValueException );
+        BOOST_CHECK_THROW( processor.process("sum 1 1.5"), InvalidParameterTypeException );
+    }
+
+    // Every way of processing hands the typed values and the matched
+    // options, that validation found, to the command
+    BOOST_AUTO_TEST_CASE( VALIDATED_VALUES )
+    {
+        Processor processor;
+        auto descriptor{ CommandDescriptor::Create("sum", "", {
+            TypedParameterDescriptor<int>::Create("a") }, {
+            OptionDescriptor::Create("o") }) };
+        std::vector<Value> values;
+        std::vector<const OptionDescriptor*> options;
+        processor.attach( descriptor, [&](const CommandLineView& cmdline) {
+            values.push_back( cmdline.getCommandParameterValue(0) );
+            options.push_back( cmdline.getOptionDescriptor(0) );
+        });
+        processor.process("sum 0x10 --o");
+        BOOST_CHECK( processor.tryProcess("sum 0x10 --o").ok() );
+        const char* const argv[]{ "sum", "0x10", "--o" };
+        processor.process( 3, argv );
+        processor.submit("sum 0x10 --o").get();
+
+        BOOST_REQUIRE_EQUAL( values.size(), 4 );
+        for( std::size_t i{0}; i < values.size(); i++ )
+        {
+            BOOST_REQUIRE( std::holds_alternative<std::int64_t>( values[i] ) );
+            BOOST_CHECK_EQUAL( std::get<std::int64_t>( values[i] ), 16 );
+            BOOST_CHECK_EQUAL( options[i], descriptor->getOptions()[0].get() );
+        }
+    }
+
     BOOST_AUTO_TEST_CASE( UNRECOGNIZED_COMMANDS )
     {
         const std::vector<std::string> undefined_commands {
@@ -70,3 +174,1000 @@ BOOST_AUTO_TEST_SUITE( PROCESSOR )
 BOOST_AUTO_TEST_SUITE_END()
 
 
+
+BOOST_AUTO_TEST_SUITE( COMMAND_MAP )
+
+    using namespace elrat::clp;
+
+    struct Counter : public Command
+    {
+        int count{0};
+        void execute(const CommandLine&) { count++; }
+    };
+
+    CommandLine createCommandLine(const std::string& name)
+    {
+        CommandLine cmdline;
+        cmdline.setCommand(name);
+        return cmdline;
+    }
+
+    BOOST_AUTO_TEST_CASE( FIND )
+    {
+        CommandMap commands;
+        auto first{ CommandDescriptor::Create("cmd") };
+        auto second{ CommandDescriptor::Create("cmd") };
+        auto command{ Command::Create<Counter>() };
+        BOOST_CHECK( !commands.find("cmd") );
+
+        commands.attach( first );
+        commands.attach( second ); // the first descriptor remains
+        commands.attach( "cmd", command );
+        auto entry{ commands.find("cmd") };
+        BOOST_REQUIRE( entry );
+        BOOST_CHECK_EQUAL( entry->descriptor, first.get() );
+        BOOST_REQUIRE_EQUAL( entry->commands.size(), 1 );
+        BOOST_CHECK_EQUAL( entry->commands[0], command );
+    }
+
+    BOOST_AUTO_TEST_CASE( DETACH )
+    {
+        CommandMap commands;
+        auto first{ std::make_shared<Counter>() };
+        auto second{ std::make_shared<Counter>() };
+        commands.attach( "cmd", first );
+        commands.attach( "cmd", second );
+
+        commands.detach( "cmd", second );
+        commands.invoke( createCommandLine("cmd") );
+        BOOST_CHECK_EQUAL( first->count, 1 );
+        BOOST_CHECK_EQUAL( second->count, 0 );
+
+        commands.detach( "cmd", second ); // not attached anymore
+        BOOST_REQUIRE( commands.find("cmd") );
+        BOOST_CHECK_EQUAL( commands.find("cmd")->commands.size(), 1 );
+
+        commands.detach( "cmd" );
+        BOOST_CHECK( !commands.find("cmd") );
+        BOOST_CHECK_THROW( commands.invoke( createCommandLine("cmd") ), CommandNotFoundException );
+        BOOST_CHECK_NO_THROW( commands.detach("unknown") );
+    }
+
+    // The remaining entries are still found, after one has been removed
+    BOOST_AUTO_TEST_CASE( DETACH_ONE_OF_SEVERAL )
+    {
+        CommandMap commands;
+        std::vector<std::shared_ptr<Counter>> counters;
+        for( int i{0}; i < 3; i++ )
+        {
+            counters.push_back( std::make_shared<Counter>() );
+            commands.attach( "cmd-" + std::to_string(i), counters.back() );
+        }
+        commands.detach( "cmd-0" );
+        BOOST_CHECK( !commands.find("cmd-0") );
+        for( int i{1}; i < 3; i++ )
+        {
+            const auto name{ "cmd-" + std::to_string(i) };
+            BOOST_REQUIRE( commands.find(name) );
+            BOOST_CHECK_EQUAL( commands.find(name)->commands[0], counters[i] );
+            BOOST_CHECK( commands.find( createCommandLine(name) ) == commands.find(name) );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE( DETACH_KEEPS_DESCRIPTOR )
+    {
+        CommandMap commands;
+        auto descriptor{ CommandDescriptor::Create("cmd") };
+        commands.attach( descriptor );
+        commands.attach( "cmd", std::make_shared<Counter>() );
+        commands.detach( "cmd" );
+        BOOST_REQUIRE( commands.find("cmd") );
+        BOOST_CHECK_EQUAL( commands.find("cmd")->descriptor, descriptor.get() );
+        BOOST_CHECK_THROW( commands.invoke( createCommandLine("cmd") ), CommandNotFoundException );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( PROCESS_BATCH )
+
+    using namespace elrat::clp;
+
+    struct Fixture
+    {
+        Processor processor;
+        std::vector<std::string> received;
+
+        Fixture()
+        {
+            processor.attach( 
+                CommandDescriptor::Create("echo", "", {
+                    ParameterDescriptor::Create("text", "", Mandatory, ParameterType::Name) }),
+                [this](const CommandLineView& cmdline) {
+                    received.emplace_back( cmdline.getCommandParameter(0) );
+                });
+            processor.attach(
+                CommandDescriptor::Create("fail"),
+                [](const CommandLineView&) { throw std::runtime_error("fail"); });
+        }
+    };
+
+    BOOST_FIXTURE_TEST_CASE( STATUS, Fixture )
+    {
+        const std::vector<std::string_view> lines {
+            "echo a1", "echo b2", "", "echo", "unknown", "echo --x", 
+            "echo c3", "fail", "echo d4 = e", "echo 1a"
+        };
+        const std::vector<LineStatus> expected {
+            LineStatus::Processed, LineStatus::Processed, LineStatus::InvalidSyntax,
+            LineStatus::InvalidArguments, LineStatus::InvalidCommand, 
+            LineStatus::InvalidArguments, LineStatus::Processed, 
+            LineStatus::CommandFailed, LineStatus::InvalidSyntax, LineStatus::InvalidArguments
+        };
+        auto status{ processor.processBatch(lines) };
+        BOOST_REQUIRE_EQUAL( status.size(), expected.size() );
+        for( std::size_t i{0}; i < status.size(); i++ )
+            BOOST_CHECK_MESSAGE( status[i] == expected[i], "line " << i << ": " << lines[i] );
+        const std::vector<std::string> echoed{ "a1", "b2", "c3" };
+        BOOST_CHECK_EQUAL_COLLECTIONS( received.begin(), received.end(), echoed.begin(), echoed.end() );
+    }
+
+    BOOST_FIXTURE_TEST_CASE( EMPTY_BATCH, Fixture )
+    {
+        BOOST_CHECK( processor.processBatch({}).empty() );
+    }
+
+    // Enough lines for the pipeline, which must yield the same status and
+    // execute the commands in the same order as processBatch().
+    BOOST_FIXTURE_TEST_CASE( PIPELINED, Fixture )
+    {
+        const std::vector<std::string_view> pattern {
+            "echo a1", "", "echo", "unknown", "fail", "echo d4 = e", "echo 1a"
+        };
+        std::vector<std::string> storage;
+        for( int i{0}; i < 5000; i++ )
+            storage.push_back( i % 3 
+                ? std::string( pattern[i % pattern.size()] ) 
+                : "echo n" + std::to_string(i) );
+        const std::vector<std::string_view> lines( storage.begin(), storage.end() );
+
+        const auto expected{ processor.processBatch(lines) };
+        const auto echoed{ received };
+        received.clear();
+        const auto status{ processor.processPipelined(lines) };
+        BOOST_REQUIRE_EQUAL( status.size(), expected.size() );
+        for( std::size_t i{0}; i < status.size(); i++ )
+            BOOST_CHECK_MESSAGE( status[i] == expected[i], "line " << i << ": " << lines[i] );
+        BOOST_CHECK_EQUAL_COLLECTIONS( received.begin(), received.end(), echoed.begin(), echoed.end() );
+
+        BOOST_CHECK( processor.processPipelined({}).empty() );
+    }
+
+    // Exceptions, that aren't std::exceptions, fail their line only
+    BOOST_FIXTURE_TEST_CASE( OTHER_EXCEPTIONS, Fixture )
+    {
+        processor.attach( CommandDescriptor::Create("throw"), 
+            [](const CommandLineView&) { throw 42; });
+        std::vector<std::string_view> lines( 5000, "echo a1" );
+        lines[2000] = "throw";
+        for( auto process : { &Processor::processBatch, &Processor::processPipelined } )
+        {
+            received.clear();
+            std::vector<LineStatus> status;
+            BOOST_REQUIRE_NO_THROW( status = (processor.*process)(lines) );
+            BOOST_REQUIRE_EQUAL( status.size(), lines.size() );
+            BOOST_CHECK( status[2000] == LineStatus::CommandFailed );
+            BOOST_CHECK( status[1999] == LineStatus::Processed );
+            BOOST_CHECK( status[2001] == LineStatus::Processed );
+            BOOST_CHECK_EQUAL( received.size(), lines.size() - 1 );
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( TRY_PROCESS )
+
+    using namespace elrat::clp;
+
+    struct Fixture
+    {
+        Processor processor;
+
+        Fixture( std::shared_ptr<Parser> parser = std::make_shared<NativeParser>() )
+        : processor{parser}
+        {
+            processor.attach( 
+                CommandDescriptor::Create("echo", "", {
+                    ParameterDescriptor::Create("text", "", Mandatory, ParameterType::Name) },{
+                    OptionDescriptor::Create("repeat", "", {
+                        TypedParameterDescriptor<int>::Create("count") }) }),
+                [](const CommandLineView&) {});
+            processor.attach( CommandDescriptor::Create("nothing") );
+            processor.attach(
+                CommandDescriptor::Create("fail"),
+                [](const CommandLineView&) { throw std::runtime_error("fail"); });
+        }
+    };
+
+    // Input, error code, token and its offset
+    struct Expected
+    {
+        std::string input;
+        ErrorCode code;
+        std::string token;
+        std::size_t offset;
+    };
+    const std::vector<Expected> expected {
+         {"echo a1", ErrorCode::None, "", std::string::npos}
+        ,{"echo a1 --repeat=2", ErrorCode::None, "", std::string::npos}
+        ,{"", ErrorCode::EmptyInput, "", std::string::npos}
+        ,{"echo a = b", ErrorCode::UnexpectedToken, "=", 7}
+        ,{"unknown a", ErrorCode::InvalidCommand, "unknown", 0}
+        ,{"nothing", ErrorCode::CommandNotFound, "nothing", 0}
+        ,{" echo", ErrorCode::MissingParameters, "echo", 1}
+        ,{"echo a b c", ErrorCode::TooManyParameters, "b", 7}
+        ,{"echo 1a", ErrorCode::InvalidParameterType, "1a", 5}
+        ,{"echo a1 --x", ErrorCode::InvalidOption, "x", 10}
+        ,{"echo a1 --repeat", ErrorCode::MissingParameters, "repeat", 10}
+        ,{"echo a1 --repeat=x", ErrorCode::InvalidParameterType, "x", 17}
+    };
+
+    BOOST_FIXTURE_TEST_CASE( DIAGNOSTICS, Fixture )
+    {
+        for( auto& e : expected )
+        {
+            auto diagnostic{ processor.tryProcess(e.input) };
+            BOOST_CHECK_MESSAGE( diagnostic.getCode() == e.code, e.input );
+            BOOST_CHECK_EQUAL( diagnostic.getToken(), e.token );
+            BOOST_CHECK_EQUAL( diagnostic.getOffset(), e.offset );
+        }
+        auto diagnostic{ processor.tryProcess("echo a b c") };
+        BOOST_CHECK_EQUAL( diagnostic.getActual(), 3 );
+        BOOST_CHECK_EQUAL( diagnostic.getExpected(), 1 );
+        BOOST_CHECK_EQUAL( 
+            diagnostic.getMessage(), 
+            "InputException: Too Many Parameters [3/1]" );
+    }
+
+    BOOST_FIXTURE_TEST_CASE( ARGUMENT_VECTOR, Fixture )
+    {
+        const char* const valid[]{ "echo", "a1", "--repeat=2" };
+        BOOST_CHECK( processor.tryProcess( 3, valid ).ok() );
+        BOOST_CHECK_NO_THROW( processor.process( 3, valid ) );
+        const char* const invalid[]{ "echo", "a1", "--repeat=x" };
+        auto diagnostic{ processor.tryProcess( 3, invalid ) };
+        BOOST_CHECK( diagnostic.getCode() == ErrorCode::InvalidParameterType );
+        BOOST_CHECK_EQUAL( diagnostic.getToken(), "x" );
+        BOOST_CHECK_THROW( processor.process( 3, invalid ), InputException );
+        const char* const failing[]{ "fail" };
+        BOOST_CHECK_THROW( processor.tryProcess( 1, failing ), std::runtime_error );
+
+        // Parsers without views get the joined arguments
+        auto native{ std::make_shared<NativeParser>() };
+        Fixture fixture( std::make_shared<ParserWrapper>( 
+            [native](const std::string& input) { return native->parse(input); }, "" ) );
+        BOOST_CHECK( fixture.processor.tryProcess( 3, valid ).ok() );
+        BOOST_CHECK( fixture.processor.tryProcess( 3, invalid ).getCode() 
+            == ErrorCode::InvalidParameterType );
+    }
+
+    // process() throws the exception, whose message the diagnostic has
+    BOOST_FIXTURE_TEST_CASE( SAME_AS_PROCESS, Fixture )
+    {
+        for( auto& e : expected )
+        {
+            auto diagnostic{ processor.tryProcess(e.input) };
+            if ( diagnostic.ok() )
+            {
+                BOOST_CHECK_NO_THROW( processor.process(e.input) );
+                continue;
+            }
+            try
+            {
+                processor.process(e.input);
+                BOOST_ERROR( "No exception: " + e.input );
+            }
+            catch( const Exception& exception )
+            {
+                BOOST_CHECK_EQUAL( diagnostic.getMessage(), exception.what() );
+            }
+        }
+    }
+
+    BOOST_FIXTURE_TEST_CASE( COMMAND_EXCEPTIONS, Fixture )
+    {
+        BOOST_CHECK_THROW( processor.tryProcess("fail"), std::runtime_error );
+    }
+
+    // Parsers without views own the tokens, so the diagnostic is detached.
+    BOOST_AUTO_TEST_CASE( WITHOUT_VIEWS )
+    {
+        auto native{ std::make_shared<NativeParser>() };
+        Fixture fixture( std::make_shared<ParserWrapper>( 
+            [native](const std::string& input) { return native->parse(input); }, "" ) );
+        for( auto& e : expected )
+        {
+            auto diagnostic{ fixture.processor.tryProcess(e.input) };
+            const bool parser_error{ 
+                e.code != ErrorCode::None && e.code < ErrorCode::InvalidCommand };
+            BOOST_CHECK_MESSAGE( 
+                diagnostic.getCode() == ( parser_error ? ErrorCode::Exception : e.code ), 
+                e.input );
+            BOOST_CHECK( diagnostic.getToken().empty() );
+            if ( diagnostic.ok() )
+                continue;
+            BOOST_CHECK_EQUAL( 
+                diagnostic.getMessage(), 
+                Fixture().processor.tryProcess(e.input).getMessage() );
+            BOOST_CHECK_THROW( diagnostic.raise(), Exception );
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( CONCURRENCY )
+
+    using namespace elrat::clp;
+
+    const int ThreadCount{ 8 };
+
+    // Every thread processes the same lines; the commands count the calls 
+    // and add up the (typed) parameters.
+    BOOST_AUTO_TEST_CASE( SHARED_PROCESSOR )
+    {
+        Processor processor;
+        std::atomic<long> calls{0};
+        std::atomic<long> sum{0};
+        for( int i{0}; i < 10; i++ )
+            processor.attach(
+                CommandDescriptor::Create( "add-" + std::to_string(i), "", {
+                    TypedParameterDescriptor<int>::Create("n") },{
+                    OptionDescriptor::Create("twice") }),
+                [&](const CommandLineView& cmdline) {
+                    const int n{ cmdline.getCommandParameterAs<int>(0) };
+                    sum += cmdline.optionExists("twice") ? 2 * n : n;
+                    calls++;
+                });
+
+        std::vector<std::string> lines;
+        long expected_sum{0};
+        int expected_calls{0};
+        for( int i{0}; i < 100; i++ )
+        {
+            lines.push_back( "add-" + std::to_string(i % 10) + " " + std::to_string(i) 
+                + ( i % 2 ? " --twice" : "" ) );
+            expected_sum += i % 2 ? 2 * i : i;
+            expected_calls++;
+        }
+        lines.push_back( "add-1 x" );
+        lines.push_back( "unknown 1" );
+        lines.push_back( "add-1 = 1" );
+        const std::vector<std::string_view> batch( lines.begin(), lines.end() );
+
+        const int rounds{ 20 };
+        std::atomic<int> rejected{0};
+        std::vector<std::thread> threads;
+        for( int t{0}; t < ThreadCount; t++ )
+            threads.emplace_back( [&, t]{
+                for( int round{0}; round < rounds; round++ )
+                {
+                    switch( (t + round) % 3 )
+                    {
+                        case 0:
+                            for( auto& line : lines )
+                            {
+                                try 
+                                {
+                                    processor.process(line);
+                                }
+                                catch( const InputException& )
+                                {
+                                    rejected++;
+                                }
+                            }
+                            break;
+                        case 1:
+                            for( auto& line : lines )
+                                if ( !processor.tryProcess(line).ok() )
+                                    rejected++;
+                            break;
+                        default:
+                            for( auto status : processor.processBatch(batch) )
+                                if ( status != LineStatus::Processed )
+                                    rejected++;
+                    }
+                }
+            });
+        for( auto& thread : threads )
+            thread.join();
+
+        BOOST_CHECK_EQUAL( calls, ThreadCount * rounds * expected_calls );
+        BOOST_CHECK_EQUAL( sum, ThreadCount * rounds * expected_sum );
+        BOOST_CHECK_EQUAL( rejected, ThreadCount * rounds * 3 );
+    }
+
+    // The built-in descriptors are created once, even by concurrent processors
+    BOOST_AUTO_TEST_CASE( CONCURRENT_CONSTRUCTION )
+    {
+        std::vector<CommandDescriptorPtr> help( ThreadCount );
+        std::vector<std::thread> threads;
+        for( int t{0}; t < ThreadCount; t++ )
+            threads.emplace_back( [&help, t]{
+                Processor processor;
+                processor.tryProcess("exit --unknown");
+                help[t] = HelpDescriptor::Create();
+            });
+        for( auto& thread : threads )
+            thread.join();
+        for( auto& descriptor : help )
+            BOOST_CHECK_EQUAL( descriptor, help[0] );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( LIVE_CONFIGURATION )
+
+    using namespace elrat::clp;
+
+    BOOST_AUTO_TEST_CASE( DETACH )
+    {
+        Processor processor;
+        int calls{0};
+        auto command{ Command::Create<CommandWrapper>( 
+            std::function<void(const CommandLineView&)>( [&calls](const CommandLineView&) { 
+                calls++; 
+            }))};
+        processor.attach( CommandDescriptor::Create("count"), command );
+        BOOST_CHECK( processor.tryProcess("count").ok() );
+        processor.detach( "count", command );
+        BOOST_CHECK( processor.tryProcess("count").getCode() == ErrorCode::CommandNotFound );
+        processor.attach( "count", command );
+        BOOST_CHECK( processor.tryProcess("count").ok() );
+        processor.detach( "count" );
+        BOOST_CHECK( processor.tryProcess("count").getCode() == ErrorCode::CommandNotFound );
+        BOOST_CHECK_EQUAL( calls, 2 );
+    }
+
+    // Attaching from within a command doesn't deadlock, and the next call
+    // sees the new command.
+    BOOST_AUTO_TEST_CASE( ATTACH_FROM_COMMAND )
+    {
+        Processor processor;
+        int calls{0};
+        processor.attach( CommandDescriptor::Create("install"), 
+            [&](const CommandLineView&) {
+                processor.attach( CommandDescriptor::Create("installed"),
+                    [&calls](const CommandLineView&) { calls++; });
+                processor.process("help");
+            });
+        BOOST_CHECK( processor.tryProcess("installed").getCode() == ErrorCode::InvalidCommand );
+        std::stringstream output;
+        auto buffer{ std::cout.rdbuf( output.rdbuf() ) };
+        processor.process("install");
+        std::cout.rdbuf( buffer );
+        BOOST_CHECK( output.str().find("installed") != std::string::npos );
+        processor.process("installed");
+        BOOST_CHECK_EQUAL( calls, 1 );
+    }
+
+    // Readers keep processing, while a writer attaches new commands and
+    // detaches them again.
+    BOOST_AUTO_TEST_CASE( ATTACH_WHILE_PROCESSING )
+    {
+        const int ReaderCount{ 4 };
+        const int CommandCount{ 200 };
+        Processor processor;
+        std::atomic<long> calls{0};
+        processor.attach( CommandDescriptor::Create("stable"), 
+            [&calls](const CommandLineView&) { calls++; });
+
+        std::atomic<bool> done{false};
+        std::atomic<long> unexpected{0};
+        std::atomic<long> stable_calls{0};
+        std::vector<std::thread> readers;
+        for( int r{0}; r < ReaderCount; r++ )
+            readers.emplace_back( [&, r]{
+                for( int i{r}; !done; i++ )
+                {
+                    if ( !processor.tryProcess("stable").ok() )
+                        unexpected++;
+                    stable_calls++;
+                    const std::string name{ "command-" + std::to_string( i % CommandCount ) };
+                    switch( processor.tryProcess(name).getCode() )
+                    {
+                        case ErrorCode::None:
+                        case ErrorCode::InvalidCommand:
+                        case ErrorCode::CommandNotFound:
+                            break;
+                        default:
+                            unexpected++;
+                    }
+                }
+            });
+
+        std::vector<CommandPtr> commands;
+        for( int i{0}; i < CommandCount; i++ )
+        {
+            commands.push_back( Command::Create<CommandWrapper>( 
+                std::function<void(const CommandLineView&)>( [&calls](const CommandLineView&) { 
+                    calls++; 
+                })));
+            processor.attach( 
+                CommandDescriptor::Create( "command-" + std::to_string(i) ), commands.back() );
+        }
+        for( int i{0}; i < CommandCount; i += 2 )
+            processor.detach( "command-" + std::to_string(i), commands[i] );
+        done = true;
+        for( auto& reader : readers )
+            reader.join();
+
+        BOOST_CHECK_EQUAL( unexpected, 0 );
+        BOOST_CHECK( calls >= stable_calls );
+        BOOST_CHECK( processor.tryProcess("command-1").ok() );
+        BOOST_CHECK( processor.tryProcess("command-2").getCode() == ErrorCode::CommandNotFound );
+    }
+
+    // A descriptor, that is attached with its command, is never seen alone
+    BOOST_AUTO_TEST_CASE( ATTACH_WITH_DESCRIPTOR )
+    {
+        const int CommandCount{ 300 };
+        Processor processor;
+        std::atomic<int> attaching{0};
+        std::atomic<bool> done{false};
+        std::atomic<long> not_found{0};
+        std::atomic<long> calls{0};
+        std::thread reader( [&]{
+            while( !done )
+            {
+                const std::string name{ "churn-" + std::to_string( attaching.load() ) };
+                if ( processor.tryProcess(name).getCode() == ErrorCode::CommandNotFound )
+                    not_found++;
+            }
+        });
+
+        for( int i{0}; i < CommandCount; i++ )
+        {
+            attaching = i;
+            const auto descriptor{ CommandDescriptor::Create( "churn-" + std::to_string(i) ) };
+            switch( i % 3 )
+            {
+                case 0:
+                    processor.attach( descriptor, [&calls](const CommandLineView&) { calls++; } );
+                    break;
+                case 1:
+                    processor.attach( descriptor, [&calls](const CommandLine&) { calls++; } );
+                    break;
+                default:
+                    processor.attachAsync( descriptor, [&calls](CommandLine) -> AsyncTask {
+                        calls++;
+                        co_return;
+                    });
+            }
+        }
+        done = true;
+        reader.join();
+
+        BOOST_CHECK_EQUAL( not_found, 0 );
+        for( int i{0}; i < CommandCount; i += 3 )
+            BOOST_CHECK( processor.tryProcess( "churn-" + std::to_string(i) ).ok() );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( SUBMIT )
+
+    using namespace elrat::clp;
+
+    BOOST_AUTO_TEST_CASE( FUTURES )
+    {
+        Processor processor;
+        processor.setExecutor( Executor::Create(4) );
+        std::atomic<int> calls{0};
+        processor.attach( 
+            CommandDescriptor::Create("count", "", {
+                TypedParameterDescriptor<int>::Create("n") }),
+            [&calls](const CommandLineView& cmdline) { 
+                calls += cmdline.getCommandParameterAs<int>(0); 
+            });
+        processor.attach(
+            CommandDescriptor::Create("fail"),
+            [](const CommandLineView&) { throw std::runtime_error("fail"); });
+
+        std::vector<std::future<Diagnostic>> futures;
+        for( int i{0}; i < 100; i++ )
+            futures.push_back( processor.submit( "count " + std::to_string(i) ) );
+        auto rejected{ processor.submit("count x") };
+        auto failed{ processor.submit("fail") };
+
+        for( auto& future : futures )
+            BOOST_CHECK( future.get().ok() );
+        auto diagnostic{ rejected.get() };
+        BOOST_CHECK( diagnostic.getCode() == ErrorCode::InvalidParameterType );
+        // Detached from the line, which is gone
+        BOOST_CHECK( diagnostic.getToken().empty() );
+        BOOST_CHECK_EQUAL( 
+            diagnostic.getMessage(), 
+            "InputException: Invalid Parameter Type [x]" );
+        BOOST_CHECK_THROW( failed.get(), std::runtime_error );
+        BOOST_CHECK_EQUAL( calls, 99 * 100 / 2 );
+    }
+
+    BOOST_AUTO_TEST_CASE( COMPLETION )
+    {
+        std::atomic<int> ok{0};
+        std::atomic<int> rejected{0};
+        std::atomic<int> calls{0};
+        {
+            Processor processor;
+            processor.attach( CommandDescriptor::Create("call"), 
+                [&calls](const CommandLineView&) { calls++; });
+            for( int i{0}; i < 100; i++ )
+                processor.submit( i % 4 ? "call" : "call x", 
+                    [&](const Diagnostic& diagnostic, std::exception_ptr exception) {
+                        if ( exception )
+                            return;
+                        if ( diagnostic.ok() )
+                            ok++;
+                        else
+                            rejected++;
+                    });
+            // The destructor drains
+        }
+        BOOST_CHECK_EQUAL( ok, 75 );
+        BOOST_CHECK_EQUAL( rejected, 25 );
+        BOOST_CHECK_EQUAL( calls, 75 );
+    }
+
+    // Lines for the same command run in the order of submission; invalid
+    // lines are only rejected.
+    BOOST_AUTO_TEST_CASE( PER_COMMAND_ORDERING )
+    {
+        const int CommandCount{ 4 };
+        Processor processor;
+        processor.setExecutor( Executor::Create(4) );
+        std::vector<std::vector<int>> seen( CommandCount );
+        for( int c{0}; c < CommandCount; c++ )
+            processor.attach( 
+                CommandDescriptor::Create( "append-" + std::to_string(c), "", {
+                    TypedParameterDescriptor<int>::Create("n") }),
+                [&seen, c](const CommandLineView& cmdline) { 
+                    // Not synchronized: the ordering serializes each command
+                    seen[c].push_back( cmdline.getCommandParameterAs<int>(0) );
+                });
+
+        std::atomic<int> rejected{0};
+        for( int i{0}; i < 2000; i++ )
+            processor.submit( 
+                "append-" + std::to_string(i % CommandCount) + " " + std::to_string(i),
+                [](const Diagnostic&, std::exception_ptr) {},
+                Ordering::PerCommand );
+        processor.submit( "append-0 = 1", 
+            [&rejected](const Diagnostic& diagnostic, std::exception_ptr) {
+                if ( !diagnostic.ok() )
+                    rejected++;
+            }, Ordering::PerCommand );
+        processor.drain();
+
+        BOOST_CHECK_EQUAL( rejected, 1 );
+        for( auto& numbers : seen )
+        {
+            BOOST_REQUIRE_EQUAL( numbers.size(), 2000 / CommandCount );
+            for( std::size_t i{1}; i < numbers.size(); i++ )
+                BOOST_CHECK_LT( numbers[i-1], numbers[i] );
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE( SHUT_DOWN_EXECUTOR )
+    {
+        Processor processor;
+        auto executor{ Executor::Create(1) };
+        processor.setExecutor( executor );
+        BOOST_CHECK_EQUAL( processor.getExecutor(), executor );
+        BOOST_CHECK_THROW( processor.setExecutor( nullptr ), NullptrAssignmentException );
+        executor->shutdown();
+        BOOST_CHECK_THROW( processor.submit("exit"), std::logic_error );
+        // Nothing is in flight
+        processor.drain();
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( ASYNC_COMMANDS )
+
+    using namespace elrat::clp;
+
+    // Many commands wait at the same time, on two threads
+    BOOST_AUTO_TEST_CASE( SUSPENDED )
+    {
+        const int LineCount{ 2000 };
+        Processor processor;
+        processor.setExecutor( Executor::Create(2) );
+        std::mutex mutex;
+        std::vector<Resumer> waiting;
+        std::atomic<int> calls{0};
+        processor.attachAsync( 
+            CommandDescriptor::Create("wait", "", {
+                TypedParameterDescriptor<int>::Create("n") }),
+            [&](CommandLine cmdline) -> AsyncTask {
+                co_await suspend( [&](Resumer resume) {
+                    std::lock_guard<std::mutex> lock( mutex );
+                    waiting.push_back( resume );
+                });
+                calls += cmdline.getCommandParameterAs<int>(0);
+            });
+
+        std::vector<std::future<Diagnostic>> futures;
+        for( int i{0}; i < LineCount; i++ )
+            futures.push_back( processor.submit( "wait " + std::to_string(i) ) );
+        auto rejected{ processor.submit("wait x") };
+        BOOST_CHECK( rejected.get().getCode() == ErrorCode::InvalidParameterType );
+
+        for( ;; )
+        {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                if ( waiting.size() == LineCount )
+                    break;
+            }
+            std::this_thread::yield();
+        }
+        BOOST_CHECK_EQUAL( calls, 0 );
+        for( auto& resume : waiting )
+            resume();
+        for( auto& future : futures )
+            BOOST_CHECK( future.get().ok() );
+        BOOST_CHECK_EQUAL( calls, (LineCount - 1) * LineCount / 2 );
+    }
+
+    AsyncTask twice(std::atomic<int>& counter)
+    {
+        co_await reschedule();
+        counter++;
+        co_await reschedule();
+        counter++;
+    }
+
+    // Synchronous and asynchronous commands for the same name run in the
+    // order they have been attached; coroutines may await coroutines.
+    BOOST_AUTO_TEST_CASE( MIXED_COMMANDS )
+    {
+        Processor processor;
+        processor.setExecutor( Executor::Create(2) );
+        std::mutex mutex;
+        std::vector<std::string> trace;
+        std::atomic<int> counter{0};
+        processor.attach( CommandDescriptor::Create("run"), 
+            [&](const CommandLineView&) {
+                std::lock_guard<std::mutex> lock( mutex );
+                trace.push_back("sync");
+            });
+        processor.attachAsync( "run", [&](CommandLine) -> AsyncTask {
+            co_await twice( counter );
+            std::lock_guard<std::mutex> lock( mutex );
+            trace.push_back("async");
+        });
+        processor.attach( "run", [&](const CommandLine&) {
+            std::lock_guard<std::mutex> lock( mutex );
+            trace.push_back("sync");
+        });
+
+        BOOST_CHECK( processor.submit("run").get().ok() );
+        BOOST_CHECK_EQUAL( counter, 2 );
+        // Synchronously, without executor
+        processor.process("run");
+        BOOST_CHECK_EQUAL( counter, 4 );
+        const std::vector<std::string> expected{ "sync", "async", "sync", "sync", "async", "sync" };
+        BOOST_CHECK_EQUAL_COLLECTIONS( trace.begin(), trace.end(), expected.begin(), expected.end() );
+    }
+
+    BOOST_AUTO_TEST_CASE( EXCEPTIONS )
+    {
+        Processor processor;
+        processor.attachAsync( CommandDescriptor::Create("fail"), [](CommandLine) -> AsyncTask {
+            co_await reschedule();
+            throw std::runtime_error("fail");
+        });
+        BOOST_CHECK_THROW( processor.submit("fail").get(), std::runtime_error );
+        BOOST_CHECK_THROW( processor.process("fail"), std::runtime_error );
+        BOOST_CHECK_THROW( processor.attachAsync( "fail", nullptr ), NullptrAssignmentException );
+    }
+
+    // The next line for a command starts, when the coroutine has finished
+    BOOST_AUTO_TEST_CASE( PER_COMMAND_ORDERING )
+    {
+        const int CommandCount{ 3 };
+        Processor processor;
+        processor.setExecutor( Executor::Create(4) );
+        std::vector<std::vector<int>> seen( CommandCount );
+        for( int c{0}; c < CommandCount; c++ )
+            processor.attachAsync( 
+                CommandDescriptor::Create( "append-" + std::to_string(c), "", {
+                    TypedParameterDescriptor<int>::Create("n") }),
+                [&seen, c](CommandLine cmdline) -> AsyncTask {
+                    co_await reschedule();
+                    // Not synchronized: the ordering serializes each command
+                    seen[c].push_back( cmdline.getCommandParameterAs<int>(0) );
+                    co_await reschedule();
+                });
+        for( int i{0}; i < 600; i++ )
+            processor.submit( 
+                "append-" + std::to_string(i % CommandCount) + " " + std::to_string(i),
+                [](const Diagnostic&, std::exception_ptr) {},
+                Ordering::PerCommand );
+        processor.drain();
+        for( auto& numbers : seen )
+        {
+            BOOST_REQUIRE_EQUAL( numbers.size(), 600 / CommandCount );
+            for( std::size_t i{1}; i < numbers.size(); i++ )
+                BOOST_CHECK_LT( numbers[i-1], numbers[i] );
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( RUN_FILE )
+
+    using namespace elrat::clp;
+
+    // A temporary script
+    struct Script
+    {
+        std::string path;
+
+        Script(const std::string& contents)
+        {
+            static std::atomic<int> count{0};
+            path = ( std::filesystem::temp_directory_path() 
+                / ( "clp-script-" + std::to_string( count++ ) ) ).string();
+            std::ofstream( path, std::ios::binary ) << contents;
+        }
+
+        ~Script()
+        {
+            std::filesystem::remove( path );
+        }
+    };
+
+    struct Fixture
+    {
+        Processor processor;
+        std::vector<std::string> received;
+
+        Fixture()
+        {
+            processor.attach( 
+                CommandDescriptor::Create("echo", "", {
+                    ParameterDescriptor::Create("text", "", Mandatory, ParameterType::Name) }),
+                [this](const CommandLineView& cmdline) {
+                    received.emplace_back( cmdline.getCommandParameter(0) );
+                });
+            processor.attach(
+                CommandDescriptor::Create("fail"),
+                [](const CommandLineView&) { throw std::runtime_error("fail"); });
+        }
+    };
+
+    const std::string contents{ 
+        "echo a1\n"
+        "\n"
+        "echo b2\r\n"
+        "echo 1a\n"
+        "  \t\n"
+        "fail\n"
+        "unknown\n"
+        "echo = \n"
+        "echo c3" };
+
+    BOOST_FIXTURE_TEST_CASE( CONTINUE, Fixture )
+    {
+        Script script( contents );
+        const auto stats{ processor.runFile( script.path, ErrorPolicy::Continue ) };
+        BOOST_CHECK_EQUAL( stats.lines, 9 );
+        BOOST_CHECK_EQUAL( stats.blank, 2 );
+        BOOST_CHECK_EQUAL( stats.processed, 3 );
+        BOOST_CHECK_EQUAL( stats.rejected, 3 );
+        BOOST_CHECK_EQUAL( stats.failed, 1 );
+        BOOST_CHECK_EQUAL( stats.bytes, contents.size() );
+        BOOST_CHECK( !stats.stopped );
+        BOOST_CHECK_EQUAL( stats.error_line, 4 );
+        BOOST_CHECK_EQUAL( stats.error_input, "echo 1a" );
+        BOOST_CHECK( stats.error.getCode() == ErrorCode::InvalidParameterType );
+        BOOST_CHECK_EQUAL( stats.error.getOffset(), 5 );
+        const std::vector<std::string> echoed{ "a1", "b2", "c3" };
+        BOOST_CHECK_EQUAL_COLLECTIONS( received.begin(), received.end(), echoed.begin(), echoed.end() );
+
+        std::ostringstream os;
+        os << stats;
+        BOOST_CHECK( os.str().find("line 4") != std::string::npos );
+    }
+
+    BOOST_FIXTURE_TEST_CASE( STOP, Fixture )
+    {
+        Script script( contents );
+        const auto stats{ processor.runFile( script.path ) };
+        BOOST_CHECK( stats.stopped );
+        BOOST_CHECK_EQUAL( stats.lines, 4 );
+        BOOST_CHECK_EQUAL( stats.processed, 2 );
+        BOOST_CHECK_EQUAL( stats.rejected, 1 );
+        BOOST_CHECK_EQUAL( received.size(), 2 );
+
+        Script failing( "echo a1\nfail\necho b2\n" );
+        const auto failed{ processor.runFile( failing.path ) };
+        BOOST_CHECK_EQUAL( failed.failed, 1 );
+        BOOST_CHECK_EQUAL( failed.error_line, 2 );
+        BOOST_CHECK_THROW( failed.error.raise(), std::runtime_error );
+
+        // Exceptions, that aren't std::exceptions, are failures as well
+        processor.attach( CommandDescriptor::Create("throw"), 
+            [](const CommandLineView&) { throw 42; });
+        Script throwing( "echo a1\nthrow\necho b2\n" );
+        RunStats thrown;
+        BOOST_REQUIRE_NO_THROW( thrown = processor.runFile( throwing.path, ErrorPolicy::Continue ) );
+        BOOST_CHECK_EQUAL( thrown.failed, 1 );
+        BOOST_CHECK_EQUAL( thrown.processed, 2 );
+        BOOST_CHECK_EQUAL( thrown.error_line, 2 );
+        BOOST_CHECK_THROW( thrown.error.raise(), int );
+    }
+
+    // Lines of only whitespace, '\r' included, are blank
+    BOOST_FIXTURE_TEST_CASE( CRLF_AND_WHITESPACE, Fixture )
+    {
+        Script script( "echo a1\r\n\r\n \r\r\n\v\f\r\n\t\n\recho b2\r\necho c3\r" );
+        const auto stats{ processor.runFile( script.path ) };
+        BOOST_CHECK_EQUAL( stats.lines, 7 );
+        BOOST_CHECK_EQUAL( stats.blank, 4 );
+        BOOST_CHECK_EQUAL( stats.processed, 3 );
+        BOOST_CHECK_EQUAL( stats.error_line, 0 );
+        const std::vector<std::string> echoed{ "a1", "b2", "c3" };
+        BOOST_CHECK_EQUAL_COLLECTIONS( received.begin(), received.end(), echoed.begin(), echoed.end() );
+    }
+
+    BOOST_FIXTURE_TEST_CASE( EMPTY_AND_MISSING_FILES, Fixture )
+    {
+        Script empty( "" );
+        const auto stats{ processor.runFile( empty.path ) };
+        BOOST_CHECK_EQUAL( stats.lines, 0 );
+        BOOST_CHECK_EQUAL( stats.error_line, 0 );
+        BOOST_CHECK_THROW( processor.runFile( empty.path + "-missing" ), FileException );
+    }
+
+    // The commands get the typed values and options, that validation found
+    BOOST_AUTO_TEST_CASE( TYPED_VALUES )
+    {
+        Processor processor;
+        auto descriptor{ CommandDescriptor::Create("sum", "", {
+            TypedParameterDescriptor<int>::Create("a") }, {
+            OptionDescriptor::Create("o") }) };
+        std::vector<std::int64_t> values;
+        int matched{0};
+        processor.attach( descriptor, [&](const CommandLineView& cmdline) {
+            const auto& value{ cmdline.getCommandParameterValue(0) };
+            if ( std::holds_alternative<std::int64_t>(value) )
+                values.push_back( std::get<std::int64_t>(value) );
+            if ( cmdline.getOptionCount()
+              && cmdline.getOptionDescriptor(0) == descriptor->getOptions()[0].get() )
+                matched++;
+        });
+        Script script( "sum 0x10 --o\nsum 3\n" );
+        BOOST_CHECK_EQUAL( processor.runFile( script.path ).processed, 2 );
+        const std::vector<std::int64_t> expected{ 16, 3 };
+        BOOST_CHECK_EQUAL_COLLECTIONS( values.begin(), values.end(), expected.begin(), expected.end() );
+        BOOST_CHECK_EQUAL( matched, 1 );
+    }
+
+    // Parsers, that don't provide views, get a copy of each line
+    BOOST_AUTO_TEST_CASE( WITHOUT_VIEWS )
+    {
+        auto native{ std::make_shared<NativeParser>() };
+        Processor processor( std::make_shared<ParserWrapper>( 
+            [native](const std::string& input) { return native->parse(input); }, "" ) );
+        int calls{0};
+        processor.attach( CommandDescriptor::Create("call"), 
+            [&calls](const CommandLine&) { calls++; });
+        Script script( "call\ncall = x\ncall\n" );
+        const auto stats{ processor.runFile( script.path, ErrorPolicy::Continue ) };
+        BOOST_CHECK_EQUAL( stats.processed, 2 );
+        BOOST_CHECK_EQUAL( stats.rejected, 1 );
+        BOOST_CHECK_EQUAL( calls, 2 );
+    }
+
+BOOST_AUTO_TEST_SUITE_END()